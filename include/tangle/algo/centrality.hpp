@@ -3,6 +3,7 @@
 #include <vector>
 #include <numeric> // For std::accumulate
 #include "tangle/graph.hpp"
+#include "tangle/io/edge_file.hpp"
 
 namespace tangle {
 namespace algo {
@@ -12,5 +13,8 @@ namespace algo {
 // For weighted graphs, if `use_weights` is true, it's the sum of the weights of connected edges.
 std::vector<double> degree_centrality(const graph::PpiGraph& graph, bool use_weights = false);
 
+// Same as above in one sequential pass over a binary edge file.
+std::vector<double> degree_centrality(const io::EdgeStream& edges, bool use_weights = false);
+
 } // namespace algo
 } // namespace tangle
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
+#include "tangle/csr_graph.hpp"
 #include "tangle/graph.hpp"
 
 namespace tangle {
@@ -10,7 +12,109 @@ namespace algo {
 // Returns a vector of vectors, where each inner vector is a community of NodeIds.
 // Note: This is a complex algorithm, and this implementation is a simplified
 // starting point, focusing on the first phase of modularity optimization.
-std::vector<std::vector<NodeId>> louvain_community(const graph::PpiGraph& graph, bool use_weights = false);
+//
+// `resolution` (γ) scales the null-model term of modularity: γ > 1 favours
+// smaller communities, γ < 1 larger ones, γ = 1 is standard modularity.
+std::vector<std::vector<NodeId>> louvain_community(const graph::PpiGraph& graph, bool use_weights = false,
+                                                   double resolution = 1.0);
+
+// Runs the Louvain modularity-optimization phase on a CSR graph and returns
+// the community label of every node. Nodes are visited in an order shuffled
+// with `seed`, so equal seeds give equal partitions. Community totals are kept
+// incrementally, making each sweep O(E). Labels are dense, numbered in order
+// of each community's smallest NodeId.
+// If `initial` is non-empty it is used as the starting partition (a warm
+// start) instead of one community per node.
+// With `threads` > 1 (0 = all hardware threads), graphs of more than a few
+// thousand nodes check each batch of the sweep for nodes that want to move
+// in parallel and then move only those. The partition is the same for any
+// thread count above one, but may differ from the single-threaded one.
+std::vector<NodeId> louvain_membership(const graph::CsrGraph& graph, bool use_weights,
+                                       std::uint64_t seed, double resolution = 1.0,
+                                       const std::vector<NodeId>& initial = {},
+                                       unsigned int threads = 1);
+
+// Groups a per-node membership vector into communities, ordered by label.
+std::vector<std::vector<NodeId>> communities_from_membership(const std::vector<NodeId>& membership);
+
+// Inverse of communities_from_membership: the label of node v is the index of
+// the community containing it. Nodes not listed in any community get their
+// own singleton label after the given communities.
+std::vector<NodeId> membership_from_communities(const std::vector<std::vector<NodeId>>& communities,
+                                                std::size_t num_nodes);
+
+// Consensus clustering (Lancichinetti & Fortunato, 2012) over `runs` seeded
+// Louvain instances executed in parallel. For every existing edge the
+// fraction of runs that put both endpoints together is accumulated, which
+// keeps memory at O(E) rather than O(N^2). Edges below `threshold` are dropped,
+// the rest are re-weighted by that fraction, and the process repeats until
+// every run agrees on every edge (or `max_iterations` is reached). The final
+// communities are the connected groups of edges the runs agree on.
+// Run r of iteration i uses seed (seed + i * runs + r), so the result does not
+// depend on the number of threads. If `threads` is 0, all hardware threads are used.
+std::vector<std::vector<NodeId>> consensus_communities(const graph::PpiGraph& graph,
+                                                       std::size_t runs,
+                                                       bool use_weights = false,
+                                                       double threshold = 0.5,
+                                                       std::uint64_t seed = 0,
+                                                       std::size_t max_iterations = 20,
+                                                       unsigned int threads = 0);
+
+// Maintains a Louvain partition while the network receives small edge deltas
+// (e.g. a new STRING/BioGRID release). Node degrees and Σ_tot are kept
+// between updates and adjusted only for the endpoints of changed edges; the
+// local-moving phase then re-optimizes just those endpoints and their
+// neighbours, following moves outward through a work queue instead of
+// sweeping the whole graph.
+class DynamicLouvain {
+public:
+    // Starts from `membership` (e.g. the output of louvain_membership) on `graph`.
+    DynamicLouvain(const graph::CsrGraph& graph, const std::vector<NodeId>& membership,
+                   bool use_weights = false, double resolution = 1.0);
+
+    // Applies an edge delta. `graph` is the network after the change: the
+    // previous network plus `added` minus `removed`. NodeIds are stable; ids
+    // beyond the previous node count are new nodes and start as singletons.
+    // Returns the number of node moves evaluated.
+    std::size_t update(const graph::CsrGraph& graph, const std::vector<graph::Edge>& added,
+                       const std::vector<graph::Edge>& removed);
+
+    // Current partition, relabelled densely in order of smallest NodeId.
+    std::vector<NodeId> membership() const;
+
+private:
+    bool use_weights_;
+    double resolution_;
+    double two_m_ = 0.0;
+    std::vector<NodeId> communities_;
+    std::vector<double> node_degrees_;
+    std::vector<double> community_total_degrees_; // Σ_tot, indexed by label
+};
+
+// Memberships of every node at every resolution of a sweep, stored as one
+// row-major matrix: row r holds the labels for resolutions[r].
+struct ResolutionSweep {
+    std::vector<double> resolutions;
+    std::vector<std::size_t> num_communities; // per resolution
+    std::size_t num_nodes = 0;
+    std::vector<NodeId> membership;           // resolutions.size() * num_nodes
+
+    NodeId label(std::size_t r, NodeId v) const { return membership[r * num_nodes + v]; }
+};
+
+// Runs Louvain at every resolution in `resolutions`. The values are sorted
+// from largest to smallest and split into contiguous chains that run in
+// parallel; within a chain each γ is warm-started from the partition of the
+// previous (slightly larger) γ, so most nodes are already settled. Rows are
+// returned in the order of the input resolutions.
+// Every chain holds at least four resolutions (unless there are fewer in
+// total); when that leaves fewer chains than threads, the remaining threads
+// are shared out to the Louvain runs of each chain.
+// If `threads` is 0, all hardware threads are used.
+ResolutionSweep resolution_sweep(const graph::CsrGraph& graph,
+                                 const std::vector<double>& resolutions,
+                                 bool use_weights = false, std::uint64_t seed = 0,
+                                 unsigned int threads = 0);
 
 } // namespace algo
 } // namespace tangle
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "tangle/compressed_graph.hpp"
+#include "tangle/csr_graph.hpp"
+#include "tangle/graph.hpp"
+#include "tangle/graph_overlay.hpp"
+#include "tangle/io/edge_file.hpp"
+
+namespace tangle {
+namespace algo {
+
+// Labels the connected components of the graph.
+// Uses a lock-free union-find over graph.edges(): edges are processed in
+// parallel, roots are linked with compare-and-swap (larger root under smaller)
+// and paths are halved during finds.
+// Returns, for each node, a dense component id in [0, C). Components are
+// numbered in order of their smallest NodeId, so the result is deterministic.
+// If `threads` is 0, all hardware threads are used.
+std::vector<NodeId> connected_components(const graph::PpiGraph& graph,
+                                         unsigned int threads = 0);
+
+// Same as above for a raw edge list over nodes [0, num_nodes).
+std::vector<NodeId> connected_components(std::size_t num_nodes,
+                                         const std::vector<graph::Edge>& edges,
+                                         unsigned int threads = 0);
+
+// Same as above in one sequential pass over a binary edge file: only the
+// parent array is held in memory, and each batch is united in parallel.
+std::vector<NodeId> connected_components(const io::EdgeStream& edges,
+                                         unsigned int threads = 0);
+
+// Same as above over a compressed adjacency: every node unites with its
+// larger neighbours while its row is decoded, in parallel.
+std::vector<NodeId> connected_components(const graph::CompressedCsrGraph& graph,
+                                         unsigned int threads = 0);
+
+// Same as above for an edited view of a graph. Runs a serial BFS sweep, since
+// overlays are meant to be evaluated many at a time in parallel. Removed
+// nodes are reported as isolated singletons.
+std::vector<NodeId> connected_components(const graph::GraphOverlay& graph);
+
+// Returns the number of nodes in each component, indexed by component id.
+std::vector<std::size_t> component_sizes(const std::vector<NodeId>& labels);
+
+// Returns the largest connected component as a new PpiGraph. Ties are broken
+// in favour of the component containing the smallest NodeId.
+graph::PpiGraph largest_component(const graph::PpiGraph& graph,
+                                  unsigned int threads = 0);
+
+struct KnockoutImpact {
+    std::size_t largest_component = 0; // nodes in the largest remaining component
+    std::size_t num_components = 0;    // components among the remaining nodes
+};
+
+// Simulates the single-node knockout of every node in `nodes` and reports the
+// component structure of what remains. Knockouts run in parallel, each as a
+// GraphOverlay over the shared CSR, so no graph is copied.
+// If `threads` is 0, all hardware threads are used.
+std::vector<KnockoutImpact> knockout_impact(const graph::CsrGraph& graph,
+                                            const std::vector<NodeId>& nodes,
+                                            unsigned int threads = 0);
+
+} // namespace algo
+} // namespace tangle
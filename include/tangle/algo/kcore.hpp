@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "tangle/graph.hpp"
+
+namespace tangle {
+namespace algo {
+
+// Computes the core number of every node: the largest k such that the node
+// belongs to the k-core (the maximal subgraph in which every node has degree >= k).
+// Uses the linear-time bucket algorithm of Batagelj & Zaversnik, O(V + E).
+// Degrees are taken from graph.neighbors(), so parallel edges count once per edge.
+std::vector<std::uint32_t> core_numbers(const graph::PpiGraph& graph);
+
+// Same result as core_numbers(), computed by level-synchronous parallel peeling:
+// all nodes of degree <= k are removed concurrently and their neighbours'
+// degrees are decremented atomically until the k-shell is exhausted.
+// If `threads` is 0, all hardware threads are used.
+std::vector<std::uint32_t> core_numbers_parallel(const graph::PpiGraph& graph,
+                                                 unsigned int threads = 0);
+
+// Returns the k-core of the graph as a new PpiGraph (nodes with core number >= k
+// and the edges between them). NodeIds are re-numbered densely.
+graph::PpiGraph k_core(const graph::PpiGraph& graph, std::uint32_t k);
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "tangle/csr_graph.hpp"
+#include "tangle/graph.hpp"
+
+namespace tangle {
+namespace algo {
+
+// Counts the triangles of the graph, each triangle once.
+// Edges are oriented from lower to higher (degree, id) rank so that every
+// triangle is found exactly once and hub out-degrees stay small; the oriented
+// neighbour lists are intersected with a SIMD merge kernel, in parallel over nodes.
+// If `threads` is 0, all hardware threads are used.
+std::uint64_t count_triangles(const graph::CsrGraph& graph, unsigned int threads = 0);
+std::uint64_t count_triangles(const graph::PpiGraph& graph, unsigned int threads = 0);
+
+// Returns the number of triangles each node participates in.
+std::vector<std::uint64_t> node_triangles(const graph::CsrGraph& graph, unsigned int threads = 0);
+
+// Computes the local clustering coefficient of each node:
+// C(v) = triangles(v) / (deg(v) * (deg(v) - 1) / 2), and 0 for deg(v) < 2.
+// Degrees are taken from the deduplicated adjacency, so parallel edges and
+// self-loops do not distort the result.
+std::vector<double> clustering_coefficient(const graph::CsrGraph& graph, unsigned int threads = 0);
+std::vector<double> clustering_coefficient(const graph::PpiGraph& graph, unsigned int threads = 0);
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "tangle/graph.hpp"
+
+namespace tangle {
+namespace algo {
+
+// Returns a degree-preserving randomisation of the graph's edge set using
+// double-edge swaps: edges (a,b),(c,d) become (a,d),(c,b) or (a,c),(b,d).
+// Swaps that would create a self-loop or a multi-edge are rejected. The input
+// is first reduced to a simple graph (see graph::CsrGraph), so the result has
+// the same degree sequence as the deduplicated network.
+//
+// Swaps are attempted concurrently: each thread locks the two edge slots it
+// picked and checks the proposed edges against a lock-free open-addressing
+// edge hash set. `swaps_per_edge * E` swaps are attempted in total.
+// Weights stay attached to edge slots, so the weight distribution is kept.
+// The returned edges use the graph's NodeIds, so no node strings are
+// re-interned; with more than one thread the exact output varies between runs.
+// If `threads` is 0, all hardware threads are used.
+std::vector<graph::Edge> randomize_edges(const graph::PpiGraph& graph,
+                                         double swaps_per_edge = 10.0,
+                                         std::uint64_t seed = 0,
+                                         unsigned int threads = 0);
+
+// Generates `count` null networks one after another, calling
+// sink(i, edges) for each so that only one null is held in memory at a time.
+// Null i is generated with seed (seed + i).
+void generate_null_models(const graph::PpiGraph& graph, std::size_t count,
+                          const std::function<void(std::size_t, const std::vector<graph::Edge>&)>& sink,
+                          double swaps_per_edge = 10.0, std::uint64_t seed = 0,
+                          unsigned int threads = 0);
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include "tangle/csr_graph.hpp"
+
+namespace tangle {
+namespace algo {
+
+struct CommunityQuality {
+    std::size_t size = 0;         // number of nodes
+    double internal_weight = 0.0; // weight of edges with both ends inside
+    double volume = 0.0;          // sum of member degrees
+    double cut_weight = 0.0;      // weight of edges leaving the community
+    double density = 0.0;         // internal_weight / (size * (size - 1) / 2)
+    double conductance = 0.0;     // cut_weight / min(volume, 2m - volume)
+};
+
+struct PartitionQuality {
+    double modularity = 0.0; // Σ_c [ w_in(c)/m - γ (vol(c)/2m)^2 ]
+    double cpm = 0.0;        // Constant Potts Model: Σ_c [ w_in(c) - γ n_c (n_c - 1) / 2 ]
+    double coverage = 0.0;   // fraction of edge weight inside communities
+    std::vector<CommunityQuality> communities; // indexed by community label
+};
+
+// Scores a partition given as a per-node membership vector (labels need not
+// be dense). All statistics come from one parallel pass over the CSR edges,
+// with per-thread accumulators merged at the end. `resolution` is the γ used
+// by both modularity and CPM. If `threads` is 0, all hardware threads are used.
+PartitionQuality evaluate_partition(const graph::CsrGraph& graph,
+                                    const std::vector<NodeId>& membership,
+                                    bool use_weights = false, double resolution = 1.0,
+                                    unsigned int threads = 0);
+
+// Normalized mutual information of two partitions of the same node set,
+// 2 I(A;B) / (H(A) + H(B)), from a sparse contingency table. Returns 1 when
+// both partitions are trivial.
+double normalized_mutual_information(const std::vector<NodeId>& a, const std::vector<NodeId>& b);
+
+// Adjusted Rand index (Hubert & Arabie) of two partitions of the same node
+// set, from a sparse contingency table. Returns 1 for identical partitions.
+double adjusted_rand_index(const std::vector<NodeId>& a, const std::vector<NodeId>& b);
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "tangle/csr_graph.hpp"
+
+namespace tangle {
+namespace algo {
+
+// Node orderings that place related nodes close together in memory.
+// NodeIds from the importers follow file-appearance order, which scatters
+// the neighbours of hubs across the CSR arrays.
+enum class NodeOrder {
+    Degree, // descending degree ("hub sorting")
+    Rcm,    // reverse Cuthill-McKee: bandwidth-reducing BFS order
+    Rabbit  // community-based order from incremental aggregation (Arai et al., 2016)
+};
+
+// Parses "degree", "rcm" or "rabbit"; throws std::invalid_argument otherwise.
+NodeOrder parse_node_order(const std::string& name);
+
+// Each ordering function returns the new id of every node: v -> new_id[v].
+
+// Descending degree; ties keep their original relative order.
+std::vector<NodeId> degree_order(const graph::CsrGraph& graph);
+
+// Reverse Cuthill-McKee. Each component is traversed breadth-first from its
+// lowest-degree node, visiting neighbours in ascending degree; the final
+// order is reversed.
+std::vector<NodeId> rcm_order(const graph::CsrGraph& graph);
+
+// Rabbit order: nodes are visited in ascending degree and merged into the
+// neighbouring community with the largest positive modularity gain, building
+// a dendrogram; a depth-first walk of the dendrogram then numbers every
+// community's members contiguously. This is a serial variant of the
+// original's lock-free parallel aggregation.
+std::vector<NodeId> rabbit_order(const graph::CsrGraph& graph);
+
+std::vector<NodeId> node_order(const graph::CsrGraph& graph, NodeOrder order);
+
+// A CSR renumbered by one of the orderings above, together with the mapping
+// back to the original NodeIds, so results can be reported against the
+// original node table.
+class ReorderedGraph {
+public:
+    ReorderedGraph(const graph::CsrGraph& graph, NodeOrder order);
+
+    const graph::CsrGraph& graph() const { return graph_; }
+
+    NodeId to_original(NodeId v) const { return original_id_[v]; }
+    NodeId to_reordered(NodeId v) const { return new_id_[v]; }
+
+    // Maps a per-node vector indexed by reordered ids back to original ids.
+    template <typename T>
+    std::vector<T> to_original(const std::vector<T>& values) const {
+        std::vector<T> out(values.size());
+        for (std::size_t v = 0; v < values.size(); ++v) out[original_id_[v]] = values[v];
+        return out;
+    }
+
+private:
+    graph::CsrGraph graph_;
+    std::vector<NodeId> new_id_;      // original -> reordered
+    std::vector<NodeId> original_id_; // reordered -> original
+};
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "tangle/io/edge_file.hpp"
+
+namespace tangle {
+namespace algo {
+
+// Semi-external algorithms: O(num_nodes) state in memory, edges streamed
+// from a binary edge file once per pass. See also the io::EdgeStream
+// overloads of degree_centrality and connected_components.
+
+// Label propagation community detection. Each pass streams every edge once
+// and lets both endpoints vote for the other's label; every node tracks its
+// running winner with a weighted Boyer-Moore majority vote, which needs one
+// (label, count) pair per node instead of a per-node label histogram. Nodes
+// start with their own label, which also counts as one vote so that ties
+// keep the current label. Labels are updated together at the end of a pass;
+// stops when no label changes or after `max_passes`.
+// Returns dense labels numbered in order of each community's smallest node.
+std::vector<NodeId> label_propagation(const io::EdgeStream& edges, std::size_t max_passes = 20,
+                                      bool use_weights = false);
+
+// PageRank of the undirected graph (each edge links both ways), by power
+// iteration with one pass over the edges per iteration. Rank of nodes
+// without edges is spread uniformly. Stops when the L1 change drops below
+// `tolerance` or after `max_iterations`. Ranks sum to 1.
+std::vector<double> pagerank(const io::EdgeStream& edges, double damping = 0.85,
+                             std::size_t max_iterations = 100, double tolerance = 1e-9,
+                             bool use_weights = false);
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "tangle/compressed_graph.hpp"
+#include "tangle/csr_graph.hpp"
+#include "tangle/graph.hpp"
+#include "tangle/graph_overlay.hpp"
+
+namespace tangle {
+namespace algo {
+
+// Distance reported for nodes that cannot be reached from the source.
+constexpr std::uint32_t kUnreachable = std::numeric_limits<std::uint32_t>::max();
+// Parent reported for the source and for unreachable nodes.
+constexpr NodeId kNoParent = std::numeric_limits<NodeId>::max();
+
+struct BfsResult {
+    std::vector<std::uint32_t> distance; // hop count from the nearest source, or kUnreachable
+    std::vector<NodeId> parent;          // BFS tree parent, or kNoParent
+};
+
+// Breadth-first search from one or more sources.
+// Uses Beamer's direction-optimizing strategy: small frontiers are expanded
+// top-down from a queue, and once the frontier's edges outweigh the unvisited
+// part of the graph the search switches to bottom-up steps, where unvisited
+// nodes look for a parent in a bitmap of the frontier. Both directions run in
+// parallel. Stops early once `target` (if not kNoParent) has been reached.
+// If `threads` is 0, all hardware threads are used.
+BfsResult bfs(const graph::CsrGraph& graph, const std::vector<NodeId>& sources,
+              NodeId target = kNoParent, unsigned int threads = 0);
+
+// Same search over a compressed adjacency, decoding rows on the fly.
+BfsResult bfs(const graph::CompressedCsrGraph& graph, const std::vector<NodeId>& sources,
+              NodeId target = kNoParent, unsigned int threads = 0);
+
+// Hop distances from `source` to every node (kUnreachable if disconnected).
+std::vector<std::uint32_t> distances_from(const graph::CsrGraph& graph, NodeId source,
+                                          unsigned int threads = 0);
+std::vector<std::uint32_t> distances_from(const graph::CompressedCsrGraph& graph, NodeId source,
+                                          unsigned int threads = 0);
+
+// Hop distances from `source` in an edited view of a graph (serial BFS).
+std::vector<std::uint32_t> distances_from(const graph::GraphOverlay& graph, NodeId source);
+
+// Returns one shortest path from u to v as a node sequence starting at u and
+// ending at v, or an empty vector if v is unreachable from u.
+std::vector<NodeId> shortest_path(const graph::CsrGraph& graph, NodeId u, NodeId v,
+                                  unsigned int threads = 0);
+
+// Returns the nodes within `k` hops of `center` (including the center), in
+// ascending NodeId order.
+std::vector<NodeId> k_hop_neighborhood(const graph::CsrGraph& graph, NodeId center,
+                                       std::uint32_t k);
+
+// Returns the k-hop ego network of `center`: the subgraph induced by every
+// node within `k` hops. NodeIds are re-numbered densely.
+graph::PpiGraph ego_network(const graph::PpiGraph& graph, NodeId center, std::uint32_t k);
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include "tangle/csr_graph.hpp"
+
+namespace tangle {
+namespace algo {
+
+// Path length reported for unreachable nodes.
+constexpr double kInfiniteDistance = std::numeric_limits<double>::infinity();
+
+// Converts edge confidence scores (e.g. STRING combined scores as loaded by
+// io::load_from_string) into additive path lengths: d = -log(score / max_score).
+// Minimising the summed length maximises the product of edge confidences.
+// Scores are clamped to (0, max_score]; use max_score = 1 for scores in [0, 1].
+// The result is aligned with graph.targets().
+std::vector<double> confidence_lengths(const graph::CsrGraph& graph, double max_score = 1000.0);
+
+struct WeightedPath {
+    std::vector<NodeId> nodes; // from source to target; empty if unreachable
+    double length = kInfiniteDistance;
+};
+
+// Single-source Dijkstra over non-negative `lengths` (aligned with
+// graph.targets()). Uses a monotone radix heap keyed on the IEEE-754 bit
+// pattern of the tentative distance.
+std::vector<double> dijkstra(const graph::CsrGraph& graph, const std::vector<double>& lengths,
+                             NodeId source);
+
+// Shortest weighted path between u and v using bidirectional Dijkstra: both
+// searches advance from the side with the smaller tentative distance and stop
+// once the two frontiers cannot improve the best meeting point.
+// With confidence_lengths(), this is the most confident path and exp(-length)
+// is the product of its normalised edge confidences.
+WeightedPath shortest_weighted_path(const graph::CsrGraph& graph, const std::vector<double>& lengths,
+                                    NodeId u, NodeId v);
+
+// Batched many-to-many distances: result[i][j] is the distance from sources[i]
+// to targets[j]. One Dijkstra per source, stopping once every target is
+// settled; sources are processed in parallel.
+// If `threads` is 0, all hardware threads are used.
+std::vector<std::vector<double>> distance_matrix(const graph::CsrGraph& graph,
+                                                 const std::vector<double>& lengths,
+                                                 const std::vector<NodeId>& sources,
+                                                 const std::vector<NodeId>& targets,
+                                                 unsigned int threads = 0);
+
+} // namespace algo
+} // namespace tangle
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "tangle/types.hpp"
-#include <set>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace tangle {
@@ -11,7 +13,31 @@ namespace annotate {
 
 using GoTermId = std::string;
 
+// Row filters applied while a GAF file is parsed. The default keeps every
+// row, as load_from_gaf(path) always has.
+struct GafFilter {
+  // Evidence codes (column 7) to keep, e.g. {"EXP", "IDA"}; empty keeps all.
+  std::vector<std::string> evidence_codes;
+  // Evidence codes to drop, e.g. {"IEA"}.
+  std::vector<std::string> excluded_evidence;
+  // Aspects (column 9) to keep, any of "P", "F", "C"; empty keeps all.
+  std::string aspects;
+  // NCBI taxon of the gene product (first entry of column 13), e.g. "9606".
+  std::string taxon;
+  // Drop rows whose qualifier (column 4) contains NOT.
+  bool skip_negated = false;
+  // Parser threads; 0 uses all hardware threads.
+  unsigned int threads = 0;
+};
+
 // Represents a database of protein-to-GO-term annotations.
+//
+// The database is immutable once loaded and kept as one flat image: sorted
+// protein and GO term names in a string pool, a protein -> term CSR, the
+// term -> protein inverted lists and the per-term protein counts. The same
+// image is what save_binary() writes and open_binary() maps back, so a
+// snapshot opens without parsing or per-string allocation. Copies share
+// the image.
 class AnnotationDb {
 public:
   AnnotationDb() = default;
@@ -21,32 +47,98 @@ public:
   // We primarily care about column 2 (DB Object ID -> ProteinId) and 5 (GO ID).
   void load_from_gaf(const std::string &filepath);
 
+  // Same, keeping only the rows that pass `filter`. Plain files are memory
+  // mapped and compressed ones streamed; either way lines are parsed in
+  // parallel as string_views, and each protein, symbol and GO id is copied
+  // once no matter how many rows mention it.
+  void load_from_gaf(const std::string &filepath, const GafFilter &filter);
+
+  // Writes the database as a binary snapshot (magic "TNGLANN1"; see
+  // annotation_db.cpp for the layout). Snapshots use the byte order of the
+  // machine that wrote them.
+  void save_binary(const std::string &filepath) const;
+
+  // Replaces the contents with a snapshot written by save_binary(). The file
+  // is memory mapped and used in place: opening parses nothing and copies no
+  // strings, it only makes one validation pass over the index arrays. Throws
+  // std::runtime_error if the header, section bounds, offsets or indices are
+  // inconsistent, so no later lookup reads outside the file. (Names that are
+  // out of order are not detected; they only make lookups miss.)
+  void open_binary(const std::string &filepath);
+
+  // True if `filepath` starts with the snapshot magic.
+  static bool is_binary_snapshot(const std::string &filepath);
+
   // Returns the set of GO terms associated with a given protein.
   // returned vector is sorted and unique.
-  const std::vector<GoTermId> &get_annotations(const ProteinId &protein) const;
+  std::vector<GoTermId> get_annotations(const ProteinId &protein) const;
 
-  // Returns all unique GO terms in the database.
+  // Calls fn(term, go_term, frequency) for every GO term of `protein` in
+  // sorted order, where `term` is the term's index in [0, num_go_terms())
+  // (indices follow the sorted names) and `frequency` the number of
+  // proteins annotated with it. Reads the index in place: one protein
+  // lookup, then no allocation or search per term. `go_term` is a view
+  // into the database.
+  template <typename Fn>
+  void for_each_annotation(std::string_view protein, Fn &&fn) const {
+    const std::size_t p = find_protein(protein);
+    if (p == std::string_view::npos) {
+      return;
+    }
+    for (std::uint64_t i = protein_start_[p]; i < protein_start_[p + 1]; ++i) {
+      const std::uint32_t t = protein_terms_[i];
+      fn(static_cast<std::size_t>(t), term_name(t),
+         static_cast<std::size_t>(term_counts_[t]));
+    }
+  }
+
+  // Returns all unique GO terms in the database, sorted.
   std::vector<GoTermId> get_all_go_terms() const;
 
-  // Returns all proteins that have at least one annotation.
+  // Returns all proteins that have at least one annotation, sorted.
   std::vector<ProteinId> get_all_annotated_proteins() const;
 
+  // Returns the proteins annotated with the given GO term, sorted.
+  std::vector<ProteinId> get_annotated_proteins(const GoTermId &go_term) const;
+
   // Returns true if a protein has any annotations.
   bool has_annotations(const ProteinId &protein) const;
 
   // Returns the number of proteins annotated with the given GO term.
-  // This is O(1) lookup.
+  // This is a binary search over the term names.
   int get_term_frequency(const GoTermId &go_term) const;
 
+  // Number of annotated proteins (the enrichment background N), without
+  // building the list.
+  std::size_t num_annotated_proteins() const { return num_proteins_; }
+
+  std::size_t num_go_terms() const { return num_terms_; }
+
 private:
-  // Maps ProteinId -> Sorted Vector of GO Term IDs
-  std::unordered_map<ProteinId, std::vector<GoTermId>> protein_to_go_;
+  struct Storage;
+
+  // Keeps the image alive; the pointers below point into it.
+  std::shared_ptr<const Storage> storage_;
+
+  std::size_t num_proteins_ = 0;
+  std::size_t num_terms_ = 0;
+  const char *pool_ = nullptr;
+  const std::uint64_t *protein_names_ = nullptr; // num_proteins_ + 1 pool offsets
+  const std::uint64_t *term_names_ = nullptr;    // num_terms_ + 1 pool offsets
+  const std::uint64_t *protein_start_ = nullptr; // CSR row starts
+  const std::uint32_t *protein_terms_ = nullptr; // term indices per protein
+  const std::uint64_t *term_start_ = nullptr;    // inverted list starts
+  const std::uint32_t *term_proteins_ = nullptr; // protein indices per term
+  const std::uint32_t *term_counts_ = nullptr;   // proteins per term
 
-  // A sorted vector of all unique GO terms present in the database.
-  std::vector<GoTermId> all_go_terms_;
+  // Validates `storage` as an image and points the views into it.
+  void attach(std::shared_ptr<const Storage> storage, const std::string &origin);
 
-  // Maps GoTermId -> Count of proteins annotated with this term
-  std::unordered_map<GoTermId, int> term_counts_;
+  std::string_view protein_name(std::size_t p) const;
+  std::string_view term_name(std::size_t t) const;
+  // Index of a protein / term, or npos if absent.
+  std::size_t find_protein(std::string_view protein) const;
+  std::size_t find_term(std::string_view go_term) const;
 };
 
 } // namespace annotate
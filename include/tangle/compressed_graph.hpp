@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "tangle/csr_graph.hpp"
+#include "tangle/types.hpp"
+
+namespace tangle {
+namespace io {
+class EdgeStream;
+} // namespace io
+
+namespace graph {
+
+namespace detail {
+
+// Reads one LEB128 varint and advances `p`.
+inline std::uint64_t read_varint(const std::uint8_t*& p) {
+    std::uint64_t value = *p & 0x7f;
+    unsigned int shift = 7;
+    while (*p++ & 0x80) {
+        value |= static_cast<std::uint64_t>(*p & 0x7f) << shift;
+        shift += 7;
+    }
+    return value;
+}
+
+// Decodes the first neighbour of a row, stored zigzag-encoded relative to
+// the row's own NodeId.
+inline NodeId decode_first(NodeId v, std::uint64_t zigzag) {
+    std::int64_t delta = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+    return static_cast<NodeId>(static_cast<std::int64_t>(v) + delta);
+}
+
+} // namespace detail
+
+// Forward iterator that decodes a compressed row on the fly.
+class CompressedNeighborIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = NodeId;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const NodeId*;
+    using reference = NodeId;
+
+    CompressedNeighborIterator() = default;
+    CompressedNeighborIterator(const std::uint8_t* p, NodeId value, std::size_t remaining)
+        : p_(p), value_(value), remaining_(remaining) {}
+
+    NodeId operator*() const { return value_; }
+
+    CompressedNeighborIterator& operator++() {
+        if (--remaining_ != 0) value_ += static_cast<NodeId>(detail::read_varint(p_)) + 1;
+        return *this;
+    }
+    CompressedNeighborIterator operator++(int) {
+        auto copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    // Iterators over the same row compare by the number of neighbours left.
+    bool operator==(const CompressedNeighborIterator& o) const { return remaining_ == o.remaining_; }
+    bool operator!=(const CompressedNeighborIterator& o) const { return remaining_ != o.remaining_; }
+
+private:
+    const std::uint8_t* p_ = nullptr; // encoding of the next neighbour
+    NodeId value_ = 0;
+    std::size_t remaining_ = 0;       // neighbours left including the current one
+};
+
+// A compressed row, iterable like NeighborRange (but forward-only).
+struct CompressedNeighborRange {
+    CompressedNeighborIterator first;
+    std::size_t count = 0;
+
+    CompressedNeighborIterator begin() const { return first; }
+    CompressedNeighborIterator end() const { return {}; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+// Topology-only CSR whose rows are stored as delta-encoded LEB128 varints:
+// the first neighbour relative to the row's NodeId (zigzag), every further
+// one as the gap to its predecessor minus one. Sorted PPI rows typically
+// need 1-2 bytes per entry instead of 4 (plus 8 for a weight) in CsrGraph.
+//
+// Each row starts with its degree (varint) followed by a block index: for
+// every kBlockSize-th entry, its byte offset in the row's gap stream and its
+// value. neighbor(v, i) and has_edge() therefore decode at most one block
+// instead of the whole row. The only per-node array is the row offsets, as
+// in CsrGraph. Weights are not stored.
+class CompressedCsrGraph {
+public:
+    static constexpr std::size_t kBlockSize = 64;
+
+    CompressedCsrGraph() = default;
+
+    // Compresses an existing CSR.
+    explicit CompressedCsrGraph(const CsrGraph& graph);
+
+    // Builds directly from an undirected edge list over nodes [0, num_nodes),
+    // without materialising a weighted CSR. Self-loops and duplicates are
+    // dropped as in CsrGraph.
+    CompressedCsrGraph(std::size_t num_nodes, const std::vector<Edge>& edges);
+
+    // Builds from a binary edge file without holding the edge list. A first
+    // pass counts degrees; the rows are then filled node range by node
+    // range, each range holding at most `buffer_entries` raw entries (or a
+    // single larger row), sorted, deduplicated and encoded. Each range is
+    // read twice, once to size its rows and once to encode them, so the
+    // encoded rows are allocated once at their final size. Peak memory is
+    // the compressed graph, two per-node arrays and one buffer of
+    // `buffer_entries` NodeIds.
+    explicit CompressedCsrGraph(const io::EdgeStream& edges, std::size_t buffer_entries = 1 << 25);
+
+    std::size_t num_nodes() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    std::size_t num_edges() const { return num_entries_ / 2; }
+
+    std::size_t degree(NodeId v) const {
+        const std::uint8_t* p = bytes_.data() + offsets_[v];
+        return static_cast<std::size_t>(detail::read_varint(p));
+    }
+
+    CompressedNeighborRange neighbors(NodeId v) const {
+        Row row = open_row(v);
+        if (row.degree == 0) return {};
+        const std::uint8_t* p = row.stream;
+        NodeId first = detail::decode_first(v, detail::read_varint(p));
+        return {CompressedNeighborIterator(p, first, row.degree), row.degree};
+    }
+
+    // The i-th smallest neighbour of v, using the block index.
+    NodeId neighbor(NodeId v, std::size_t i) const;
+
+    bool has_edge(NodeId u, NodeId v) const;
+
+    // Bytes used by the encoded rows and the offset array.
+    std::size_t memory_bytes() const {
+        return bytes_.size() + offsets_.size() * sizeof(EdgeId);
+    }
+
+private:
+    // Block index entries are two unaligned 32-bit words: byte offset, value.
+    static constexpr std::size_t kBlockEntryBytes = 8;
+
+    struct Row {
+        std::size_t degree;
+        const std::uint8_t* blocks; // num_blocks(degree) index entries
+        const std::uint8_t* stream; // gap-encoded neighbours
+    };
+
+    Row open_row(NodeId v) const {
+        const std::uint8_t* p = bytes_.data() + offsets_[v];
+        std::size_t degree = static_cast<std::size_t>(detail::read_varint(p));
+        std::size_t blocks = degree == 0 ? 0 : (degree - 1) / kBlockSize;
+        return {degree, p, p + blocks * kBlockEntryBytes};
+    }
+
+    std::vector<std::uint8_t> bytes_;
+    std::vector<EdgeId> offsets_; // byte offset of each row
+    std::size_t num_entries_ = 0;
+
+    // Shared by the in-memory constructors: encodes rows given by row(v),
+    // which must return a sorted, duplicate-free NeighborRange.
+    template <typename RowFn>
+    void encode(std::size_t num_nodes, RowFn&& row);
+
+    // Encoded size of a sorted, duplicate-free row, and the encoding itself
+    // written to `p`.
+    static std::size_t row_bytes(NodeId v, NeighborRange nbrs);
+    static void write_row(std::uint8_t* p, NodeId v, NeighborRange nbrs);
+};
+
+} // namespace graph
+} // namespace tangle
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "tangle/graph.hpp"
+#include "tangle/types.hpp"
+
+namespace tangle {
+namespace graph {
+
+// A read-only view over a contiguous array, used to expose CSR rows.
+template <typename T>
+struct Range {
+    const T* first = nullptr;
+    const T* last = nullptr;
+
+    const T* begin() const { return first; }
+    const T* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+    const T& operator[](std::size_t i) const { return first[i]; }
+};
+
+using NeighborRange = Range<NodeId>;
+using WeightRange = Range<Weight>;
+
+// Compressed sparse row adjacency of an undirected graph.
+// Every undirected edge is stored in both directions. Neighbour lists are
+// sorted by NodeId and free of duplicates and self-loops; when the source
+// graph contains parallel edges, the largest weight is kept.
+// NodeIds are the same as in the PpiGraph the CSR was built from.
+class CsrGraph {
+public:
+    CsrGraph() = default;
+
+    // Builds the CSR from a PpiGraph's edge list.
+    explicit CsrGraph(const PpiGraph& graph);
+
+    // Builds the CSR from a raw edge list over nodes [0, num_nodes).
+    CsrGraph(std::size_t num_nodes, const std::vector<Edge>& edges);
+
+    // Returns a copy with node v renamed to new_id[v]. `new_id` must be a
+    // permutation of [0, num_nodes); rows stay sorted.
+    CsrGraph permute(const std::vector<NodeId>& new_id) const;
+
+    std::size_t num_nodes() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    // Number of undirected edges (each stored twice internally).
+    std::size_t num_edges() const { return targets_.size() / 2; }
+
+    std::size_t degree(NodeId v) const { return offsets_[v + 1] - offsets_[v]; }
+
+    NeighborRange neighbors(NodeId v) const {
+        return {targets_.data() + offsets_[v], targets_.data() + offsets_[v + 1]};
+    }
+
+    // Weights aligned with neighbors(v).
+    WeightRange neighbor_weights(NodeId v) const {
+        return {weights_.data() + offsets_[v], weights_.data() + offsets_[v + 1]};
+    }
+
+    const std::vector<EdgeId>& offsets() const { return offsets_; }
+    const std::vector<NodeId>& targets() const { return targets_; }
+    const std::vector<Weight>& weights() const { return weights_; }
+
+private:
+    std::vector<EdgeId> offsets_;
+    std::vector<NodeId> targets_;
+    std::vector<Weight> weights_;
+};
+
+} // namespace graph
+} // namespace tangle
@@ -2,18 +2,43 @@
 
 #include <string>
 #include "tangle/graph.hpp"
+#include "tangle/io/input_file.hpp"
 
 namespace tangle {
 namespace export_ {
 
+enum class SbmlFormat {
+    // SBML Level 2 Version 5 core: proteins as <species>, interactions as
+    // <reaction> elements with the two proteins as reactants.
+    Level2,
+    // SBML Level 3 Version 1 with the qual package: proteins as
+    // <qual:qualitativeSpecies>, interactions as <qual:transition> elements
+    // from the first protein to the second.
+    Level3Qual,
+};
+
+struct SbmlOptions {
+    SbmlFormat format = SbmlFormat::Level2;
+    // Gzip or Zstd compresses the file while it is written.
+    io::Compression compression = io::Compression::None;
+    // Formatting (and compression) threads; 0 uses all hardware threads.
+    unsigned int threads = 0;
+};
+
 // Exports a PpiGraph to an SBML file.
-// This is a minimal implementation that creates a basic SBML Level 2 Version 5 file.
-// - Proteins are represented as <species>.
-// - Interactions are represented as <reaction> elements with the two proteins as reactants.
+// Protein ids that are valid SBML ids are used as species ids as they are.
+// Others, such as "9606.ENSP00000000233", become "s<NodeId>_" followed by
+// the id with invalid characters replaced by '_' (as are ids that could
+// clash with generated ones, e.g. "s12" or "r0"), so all ids stay unique. The protein id itself
+// goes into the name attribute, XML-escaped. Reactions / transitions are
+// "r<i>" / "t<i>" in edge order. Species and reaction blocks are formatted
+// in parallel chunks and streamed to the file.
 //
 // @param graph The graph to export.
 // @param filepath The path to the output SBML file.
 void save_to_sbml(const graph::PpiGraph& graph, const std::string& filepath);
 
+void save_to_sbml(const graph::PpiGraph& graph, const std::string& filepath, const SbmlOptions& options);
+
 } // namespace export_
 } // namespace tangle
@@ -56,5 +56,34 @@ private:
 
 };
 
+// Returns the subgraph induced by the nodes for which keep[id] is true.
+// Surviving nodes are re-numbered densely in their original order; protein
+// ids, gene symbols and edge weights are preserved.
+PpiGraph induced_subgraph(const PpiGraph& graph, const std::vector<bool>& keep);
+
+// How the weights of duplicate edges are combined when collapsing them.
+enum class EdgeMerge {
+    Max,   // strongest evidence (e.g. STRING's A-B and B-A rows)
+    Sum,
+    Mean,
+    Count  // weight becomes the number of collapsed rows (e.g. BioGRID evidence)
+};
+
+// Returns the canonical form of an undirected edge list: every edge as
+// (min, max), self-loops dropped, duplicates merged with `merge`, sorted by
+// (u, v). Uses a parallel LSD radix sort on the packed (min, max) key.
+// If `threads` is 0, all hardware threads are used.
+std::vector<Edge> canonicalize_edges(const std::vector<Edge>& edges,
+                                     EdgeMerge merge = EdgeMerge::Max,
+                                     unsigned int threads = 0);
+
+// Returns a copy of `graph` with the same node table and its edges
+// canonicalized as above.
+PpiGraph collapse_multi_edges(const PpiGraph& graph, EdgeMerge merge = EdgeMerge::Max,
+                              unsigned int threads = 0);
+
+// Parses "max", "sum", "mean" or "count"; throws std::invalid_argument otherwise.
+EdgeMerge parse_edge_merge(const std::string& name);
+
 } // namespace graph
 } // namespace tangle
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "tangle/csr_graph.hpp"
+#include "tangle/types.hpp"
+
+namespace tangle {
+namespace graph {
+
+// A copy-on-write view of an immutable CsrGraph with node and edge edits.
+// Deletions and additions are recorded in small side structures; the base
+// graph is never copied or modified, so many what-if scenarios (e.g. one per
+// in-silico knockout) can share one base, and reset() makes an overlay
+// reusable without reallocating.
+//
+// NodeIds of the base are kept. Added nodes get ids after the base's last
+// node. Removed nodes keep their id but have no neighbours and can no longer
+// be edited. The base graph must outlive the overlay.
+class GraphOverlay {
+public:
+    explicit GraphOverlay(const CsrGraph& base) : base_(&base) {}
+
+    const CsrGraph& base() const { return *base_; }
+
+    // Total number of node ids, including removed and added nodes.
+    std::size_t num_nodes() const { return base_->num_nodes() + added_nodes_; }
+
+    // Appends a new isolated node and returns its id.
+    NodeId add_node();
+
+    // Removes `v` together with all its edges. No-op if already removed.
+    void remove_node(NodeId v);
+
+    // Adds an undirected edge. No-op if the edge already exists.
+    // Throws std::invalid_argument for self-loops or removed endpoints.
+    void add_edge(NodeId u, NodeId v, Weight w = 1.0);
+
+    // Removes the undirected edge between u and v. No-op if absent.
+    void remove_edge(NodeId u, NodeId v);
+
+    bool is_removed(NodeId v) const {
+        return !removed_nodes_.empty() &&
+               std::binary_search(removed_nodes_.begin(), removed_nodes_.end(), v);
+    }
+
+    bool has_edge(NodeId u, NodeId v) const;
+
+    // Degree of `v` in the edited graph, in O(1).
+    std::size_t degree(NodeId v) const;
+
+    // Calls fn(neighbor, weight) for every neighbour of `v` in the edited
+    // graph: surviving base neighbours in ascending order, then added ones.
+    template <typename Fn>
+    void for_each_neighbor(NodeId v, Fn&& fn) const {
+        if (is_removed(v)) return;
+        if (v < base_->num_nodes()) {
+            NeighborRange nbrs = base_->neighbors(v);
+            WeightRange weights = base_->neighbor_weights(v);
+            const bool filter = !removed_nodes_.empty() || !removed_edges_.empty();
+            for (std::size_t i = 0; i < nbrs.size(); ++i) {
+                NodeId u = nbrs[i];
+                if (filter && (is_removed(u) || removed_edges_.count(edge_key(u, v)))) continue;
+                fn(u, weights[i]);
+            }
+        }
+        auto it = added_edges_.find(v);
+        if (it != added_edges_.end()) {
+            for (const auto& [u, w] : it->second) fn(u, w);
+        }
+    }
+
+    // True if no edits have been recorded.
+    bool empty() const {
+        return added_nodes_ == 0 && removed_nodes_.empty() && removed_edges_.empty() &&
+               added_edges_.empty();
+    }
+
+    // Discards all edits, restoring the base graph view.
+    void reset();
+
+private:
+    const CsrGraph* base_;
+    std::size_t added_nodes_ = 0;
+    std::vector<NodeId> removed_nodes_;                  // sorted
+    std::unordered_set<std::uint64_t> removed_edges_;    // base edges, by edge_key
+    std::unordered_map<NodeId, std::vector<std::pair<NodeId, Weight>>> added_edges_;
+    std::unordered_map<NodeId, std::int64_t> degree_delta_;
+
+    static std::uint64_t edge_key(NodeId u, NodeId v) {
+        if (u > v) std::swap(u, v);
+        return (static_cast<std::uint64_t>(u) << 32) | v;
+    }
+
+    bool has_base_edge(NodeId u, NodeId v) const;
+    bool erase_added(NodeId u, NodeId v);
+    void check_node(NodeId v) const;
+};
+
+} // namespace graph
+} // namespace tangle
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "tangle/graph.hpp"
+
+namespace tangle {
+namespace io {
+
+// Binary edge files for semi-external processing: node state stays in RAM
+// while edges are streamed from disk in sequential passes.
+//
+// Layout: an 8-byte magic "TNGLEDG1", the node and edge counts as uint64,
+// then the raw graph::Edge records (u, v as uint32, weight as double).
+// Protein ids are kept next to it in a "<path>.nodes" text file, one per
+// line in NodeId order.
+
+// Appends edges to a new binary edge file through a fixed-size buffer.
+class EdgeFileWriter {
+public:
+    explicit EdgeFileWriter(const std::string& path, std::size_t buffer_edges = 1 << 16);
+    ~EdgeFileWriter();
+
+    EdgeFileWriter(const EdgeFileWriter&) = delete;
+    EdgeFileWriter& operator=(const EdgeFileWriter&) = delete;
+
+    void add_edge(NodeId u, NodeId v, Weight w = 1.0);
+
+    // Flushes and writes the header. The node count is at least one more
+    // than the largest NodeId written. Until this is called the file has no
+    // valid header; a writer destroyed without finish() leaves a file that
+    // EdgeStream rejects.
+    void finish(std::size_t num_nodes = 0);
+
+    std::size_t num_edges() const { return num_edges_; }
+
+private:
+    std::ofstream out_;
+    std::vector<graph::Edge> buffer_;
+    std::size_t capacity_;
+    std::size_t num_edges_ = 0;
+    std::size_t num_nodes_ = 0;
+    bool finished_ = false;
+
+    void flush();
+};
+
+// Read side of a binary edge file. Each pass re-reads the file from the
+// start in batches, so memory use is bounded by the batch size.
+class EdgeStream {
+public:
+    explicit EdgeStream(const std::string& path, std::size_t batch_edges = 1 << 20);
+
+    std::size_t num_nodes() const { return num_nodes_; }
+    std::size_t num_edges() const { return num_edges_; }
+    const std::string& path() const { return path_; }
+
+    // Makes one sequential pass, calling fn(const graph::Edge* edges, count)
+    // for every batch.
+    template <typename Fn>
+    void for_each_batch(Fn&& fn) const {
+        std::ifstream in = open_at_edges();
+        std::vector<graph::Edge> batch(std::min(batch_edges_, std::max<std::size_t>(num_edges_, 1)));
+        std::size_t left = num_edges_;
+        while (left > 0) {
+            std::size_t count = std::min(left, batch.size());
+            if (!in.read(reinterpret_cast<char*>(batch.data()),
+                         static_cast<std::streamsize>(count * sizeof(graph::Edge)))) {
+                throw std::runtime_error("Truncated edge file: " + path_);
+            }
+            fn(static_cast<const graph::Edge*>(batch.data()), count);
+            left -= count;
+        }
+    }
+
+    // Convenience wrapper calling fn(edge) for every edge of one pass.
+    template <typename Fn>
+    void for_each_edge(Fn&& fn) const {
+        for_each_batch([&](const graph::Edge* edges, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) fn(edges[i]);
+        });
+    }
+
+private:
+    std::string path_;
+    std::size_t batch_edges_;
+    std::size_t num_nodes_ = 0;
+    std::size_t num_edges_ = 0;
+
+    std::ifstream open_at_edges() const;
+};
+
+// True if `path` starts with the binary edge file magic.
+bool is_edge_file(const std::string& path);
+
+// Writes a PpiGraph's edges and node table in the binary format.
+void save_edge_file(const graph::PpiGraph& graph, const std::string& path);
+
+// Converts a text edgelist (as read by load_edgelist) to a binary edge file
+// line by line, without building a PpiGraph; only the protein id table is
+// held in memory. Writes "<edge_path>.nodes" and returns the protein ids.
+std::vector<ProteinId> convert_edgelist(const std::string& text_path, const std::string& edge_path,
+                                        bool weighted = false, char delimiter = '\t');
+
+// Writes the protein ids of an edge file, one per line in NodeId order.
+void save_node_table(const std::vector<ProteinId>& names, const std::string& edge_path);
+
+// Reads the "<edge_path>.nodes" table written alongside an edge file.
+std::vector<ProteinId> load_node_table(const std::string& edge_path);
+
+} // namespace io
+} // namespace tangle
@@ -19,5 +19,10 @@ graph::PpiGraph load_edgelist(const std::string& filepath, bool weighted = false
 // separated by the specified delimiter.
 void save_edgelist(const graph::PpiGraph& graph, const std::string& filepath, bool weighted = false, char delimiter = '\t');
 
+// Saves an explicit edge list whose NodeIds refer to `graph`'s nodes, e.g. a
+// randomised null model that shares the original node table.
+void save_edgelist(const graph::PpiGraph& graph, const std::vector<graph::Edge>& edges,
+                   const std::string& filepath, bool weighted = false, char delimiter = '\t');
+
 } // namespace io
 } // namespace tangle
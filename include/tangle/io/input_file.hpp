@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+namespace tangle {
+namespace io {
+
+enum class Compression { None, Gzip, Zstd };
+
+// Sniffs the magic bytes at the start of `path` (1f 8b for gzip,
+// 28 b5 2f fd for zstd). Unreadable or short files report None.
+Compression detect_compression(const std::string& path);
+
+// True if this build can decompress `c`. Gzip needs zlib and zstd needs
+// libzstd at configure time; None is always supported.
+bool compression_supported(Compression c);
+
+// Text input for the importers that reads plain, gzip and zstd files alike.
+// Plain files go through a std::filebuf. Compressed files are inflated on a
+// background thread into a ring of `chunks` buffers of `chunk_bytes` each,
+// which the parser drains as the producer refills them, so decompression
+// and parsing overlap.
+//
+// Behaves like std::ifstream for reading: check is_open() after
+// construction. Corrupt compressed data throws std::runtime_error from the
+// read that reaches it. Throws std::runtime_error up front if the file is
+// compressed in a format this build does not support.
+class InputFile : public std::istream {
+public:
+    explicit InputFile(const std::string& path, std::size_t chunk_bytes = 1 << 18,
+                       std::size_t chunks = 4);
+    ~InputFile() override;
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+
+    bool is_open() const { return open_; }
+    Compression compression() const { return compression_; }
+
+private:
+    std::unique_ptr<std::streambuf> buf_;
+    Compression compression_ = Compression::None;
+    bool open_ = false;
+};
+
+} // namespace io
+} // namespace tangle
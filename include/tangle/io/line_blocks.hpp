@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <string_view>
+#include <vector>
+#include "tangle/parallel.hpp"
+
+namespace tangle {
+namespace io {
+
+namespace detail {
+
+// Parses the complete lines of `text` on `threads` chunks, then consumes
+// the records in order.
+template <typename Record, typename ParseFn, typename ConsumeFn>
+void parse_block(std::string_view text, ParseFn& parse, ConsumeFn& consume,
+                 std::vector<std::vector<Record>>& records, unsigned int threads) {
+    const std::size_t end = text.size();
+    // A line belongs to the chunk its first byte falls in.
+    parallel::for_each_chunk(0, end, [&](std::size_t lo, std::size_t hi, unsigned int t) {
+        std::size_t start = lo;
+        if (start > 0 && text[start - 1] != '\n') {
+            start = text.find('\n', start);
+            if (start == std::string_view::npos) return;
+            ++start;
+        }
+        while (start < hi) {
+            std::size_t stop = text.find('\n', start);
+            if (stop == std::string_view::npos) stop = end;
+            std::string_view line = text.substr(start, stop - start);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            parse(line, records[t]);
+            start = stop + 1;
+        }
+    }, threads);
+
+    for (auto& chunk : records) {
+        for (const auto& record : chunk) consume(record);
+        chunk.clear();
+    }
+}
+
+} // namespace detail
+
+// Parses a line-oriented text stream in parallel, one block at a time.
+//
+// Reads about `block_bytes` of text, cuts the block after its last newline
+// (the partial line is carried into the next block) and splits it into one
+// contiguous run of lines per thread. parse(line, records) is called on
+// every line with the calling thread's std::vector<Record>; lines are
+// passed without their "\n" or "\r\n". Once a block is parsed,
+// consume(record) runs serially over all records in file order.
+//
+// Lines are views into the block buffer, not copies, so records may hold
+// string_views into them; those stay valid until the block's last
+// consume() returns. `parse` runs on worker threads and must not throw.
+template <typename Record, typename ParseFn, typename ConsumeFn>
+void parse_line_blocks(std::istream& in, ParseFn&& parse, ConsumeFn&& consume,
+                       unsigned int threads = 0, std::size_t block_bytes = 16 << 20) {
+    if (threads == 0) threads = parallel::num_threads();
+    block_bytes = std::max<std::size_t>(block_bytes, 1);
+    std::vector<std::vector<Record>> records(threads);
+    std::vector<char> block;
+    std::size_t carry = 0; // bytes of an unfinished line at the front of `block`
+
+    bool eof = false;
+    while (!eof) {
+        block.resize(carry + block_bytes);
+        in.read(block.data() + carry, static_cast<std::streamsize>(block_bytes));
+        const auto got = static_cast<std::size_t>(in.gcount());
+        eof = got < block_bytes;
+        const std::size_t size = carry + got;
+
+        // At end of input the last line may lack a newline; otherwise stop
+        // after the last one, or read more if the block holds no full line.
+        std::size_t end = size;
+        if (!eof) {
+            const char* data = block.data();
+            std::size_t nl = size;
+            while (nl > 0 && data[nl - 1] != '\n') --nl;
+            if (nl == 0) {
+                carry = size;
+                continue;
+            }
+            end = nl;
+        }
+
+        detail::parse_block(std::string_view(block.data(), end), parse, consume, records, threads);
+
+        carry = size - end;
+        if (carry > 0) std::memmove(block.data(), block.data() + end, carry);
+    }
+}
+
+// Same as above over text already in memory (e.g. a MappedFile), cut into
+// blocks of about `block_bytes` without copying. Lines, and any views the
+// records hold into them, stay valid as long as `text` does.
+template <typename Record, typename ParseFn, typename ConsumeFn>
+void parse_line_blocks(std::string_view text, ParseFn&& parse, ConsumeFn&& consume,
+                       unsigned int threads = 0, std::size_t block_bytes = 16 << 20) {
+    if (threads == 0) threads = parallel::num_threads();
+    block_bytes = std::max<std::size_t>(block_bytes, 1);
+    std::vector<std::vector<Record>> records(threads);
+
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        std::size_t end = text.size();
+        if (text.size() - pos > block_bytes) {
+            const std::size_t nl = text.find('\n', pos + block_bytes - 1);
+            if (nl != std::string_view::npos) end = nl + 1;
+        }
+        detail::parse_block(text.substr(pos, end - pos), parse, consume, records, threads);
+        pos = end;
+    }
+}
+
+} // namespace io
+} // namespace tangle
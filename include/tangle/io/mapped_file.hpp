@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace tangle {
+namespace io {
+
+// Read-only view of a whole file. On POSIX systems the file is memory
+// mapped (and advised for sequential access), so parsers can slice it
+// into string_views without copying; elsewhere it is read into memory.
+// Only meant for uncompressed files: compressed input goes through
+// InputFile.
+//
+// Check is_open() after construction, like std::ifstream. An empty file is
+// open with an empty text().
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return open_; }
+    std::string_view text() const { return std::string_view(data_, size_); }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    bool open_ = false;
+    std::string buffer_; // fallback when the file is not mapped
+};
+
+} // namespace io
+} // namespace tangle
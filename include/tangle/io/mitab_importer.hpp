@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "tangle/graph.hpp"
+
+namespace tangle {
+namespace io {
+
+// Options for load_from_mitab.
+struct MitabOptions {
+    // Identifier namespace used for node ids, e.g. "uniprotkb", "entrez gene/locuslink"
+    // or "intact". Looked up among the primary ids (columns 1/2), then the alternative
+    // ids (columns 3/4); rows where either side has none are skipped. If empty, the
+    // first primary id of each interactor is used whatever its namespace.
+    std::string id_database = "uniprotkb";
+
+    // PSI-MI term ids to keep, e.g. {"MI:0915"} (physical association) for column 12
+    // and {"MI:0018"} (two hybrid) for column 7. A row passes if any of its terms is
+    // listed; empty keeps everything. Terms are matched exactly, not by ontology descendants.
+    std::vector<std::string> interaction_types;
+    std::vector<std::string> detection_methods;
+
+    // NCBI taxon id both interactors must belong to (columns 10/11), e.g. "9606".
+    // Empty keeps every species.
+    std::string taxon;
+
+    // Confidence score used as edge weight, by its name in column 15, e.g.
+    // "intact-miscore". Rows without it are skipped and rows scoring below
+    // min_score are dropped. If empty, every edge has weight 1.
+    std::string score_name;
+    double min_score = 0.0;
+
+    unsigned int threads = 0;          // 0 = parallel::num_threads()
+    std::size_t block_bytes = 16 << 20; // text parsed per parallel step
+};
+
+// Loads a graph from a PSI-MI TAB 2.5/2.6/2.7 file (BioGRID, IntAct, MINT, ...).
+// Only the first 15 columns, common to all versions, are read. Multi-valued
+// columns are '|'-separated "db:value(description)" entries and "-" marks an
+// empty column. Blocks of lines are parsed on all threads; node ids are
+// assigned serially in file order, so the result does not depend on the
+// thread count. Every row becomes an edge, so repeated pairs are kept (see
+// graph::collapse_multi_edges). Gzip/zstd input is read directly.
+graph::PpiGraph load_from_mitab(const std::string& filepath, const MitabOptions& options = {});
+
+} // namespace io
+} // namespace tangle
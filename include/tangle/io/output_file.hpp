@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "tangle/io/input_file.hpp"
+#include "tangle/parallel.hpp"
+
+namespace tangle {
+namespace io {
+
+// Growable text buffer with std::to_chars number formatting. Numbers come
+// out as they would from a default-formatted std::ostream: integers in
+// decimal, floating point as printf "%g" (6 significant digits).
+class TextBuffer {
+public:
+    TextBuffer& operator<<(std::string_view s) {
+        text_.append(s.data(), s.size());
+        return *this;
+    }
+    TextBuffer& operator<<(const char* s) { return *this << std::string_view(s); }
+    TextBuffer& operator<<(const std::string& s) { return *this << std::string_view(s); }
+    TextBuffer& operator<<(char c) {
+        text_.push_back(c);
+        return *this;
+    }
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, char>::value &&
+                                          !std::is_same<T, bool>::value>>
+    TextBuffer& operator<<(T value) {
+        char digits[24];
+        auto res = std::to_chars(digits, digits + sizeof(digits), value);
+        text_.append(digits, res.ptr);
+        return *this;
+    }
+
+    TextBuffer& operator<<(double value) {
+        char digits[32];
+        auto res = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+        text_.append(digits, res.ptr);
+        return *this;
+    }
+    TextBuffer& operator<<(float value) { return *this << static_cast<double>(value); }
+
+    std::string_view view() const { return text_; }
+    std::size_t size() const { return text_.size(); }
+    void reserve(std::size_t bytes) { text_.reserve(bytes); }
+    void clear() { text_.clear(); }
+
+private:
+    std::string text_;
+};
+
+// Buffered text output for the writers. Formatting goes into a TextBuffer
+// of about `buffer_bytes`, which is handed to the OS in one write when full,
+// so the per-field cost is a to_chars call and a memcpy.
+//
+// With `compression` set to Gzip or Zstd, every flushed buffer is written as
+// one independent gzip member / zstd frame. Readers (including InputFile)
+// treat the concatenation as a single stream, and it lets write_records
+// compress chunks on all threads. Throws std::runtime_error up front if this
+// build lacks the codec.
+//
+// Check is_open() after construction, like std::ofstream. close() flushes
+// and throws std::runtime_error if any write failed; the destructor closes
+// too but swallows errors.
+class OutputFile {
+public:
+    explicit OutputFile(const std::string& path, std::size_t buffer_bytes = 1 << 20,
+                        Compression compression = Compression::None);
+    ~OutputFile();
+
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+    bool is_open() const { return file_ != nullptr; }
+    const std::string& path() const { return path_; }
+    Compression compression() const { return compression_; }
+
+    template <typename T>
+    OutputFile& operator<<(const T& value) {
+        buffer_ << value;
+        if (buffer_.size() >= capacity_) flush();
+        return *this;
+    }
+
+    // Writes pre-formatted text, bypassing the buffer when it is large.
+    void write(std::string_view text);
+
+    // Returns `text` as it would be stored in the file: unchanged, or as
+    // one compressed member. Safe to call from several threads at once.
+    std::string encode(std::string_view text) const;
+
+    // Writes bytes returned by encode() after any buffered text.
+    void write_encoded(std::string_view bytes);
+
+    // Hands the buffered text to the OS.
+    void flush();
+
+    void close();
+
+private:
+    std::FILE* file_ = nullptr;
+    std::string path_;
+    TextBuffer buffer_;
+    std::size_t capacity_;
+    Compression compression_;
+    bool failed_ = false;
+
+    void put(std::string_view bytes);
+};
+
+// Writes records [0, count) to `out` in order, calling
+// format(i, TextBuffer&) for each. Runs of `chunk_records` records are
+// formatted (and, for compressed files, encoded) on `threads` threads into
+// separate buffers that are then written one after another, so the text is
+// identical to a serial loop and memory stays bounded by threads * chunk
+// size. `format` runs concurrently and must not throw; validate inputs
+// before calling. If `threads` is 0, parallel::num_threads() is used.
+template <typename FormatFn>
+void write_records(OutputFile& out, std::size_t count, FormatFn&& format, unsigned int threads = 0,
+                   std::size_t chunk_records = 1 << 15) {
+    if (threads == 0) threads = parallel::num_threads();
+    if (chunk_records == 0) chunk_records = 1;
+    if (threads <= 1 || count <= chunk_records) {
+        TextBuffer text;
+        for (std::size_t i = 0; i < count; ++i) {
+            format(i, text);
+            if (text.size() >= (1 << 20)) {
+                out.write(text.view());
+                text.clear();
+            }
+        }
+        out.write(text.view());
+        return;
+    }
+
+    // Compressed output is encoded on the formatting threads as well.
+    const bool compressed = out.compression() != Compression::None;
+    std::vector<TextBuffer> chunks(threads);
+    std::vector<std::string> encoded(compressed ? threads : 0);
+    const std::size_t batch = chunk_records * threads;
+    for (std::size_t base = 0; base < count; base += batch) {
+        const std::size_t n_chunks = (std::min(batch, count - base) + chunk_records - 1) / chunk_records;
+        parallel::for_each_chunk(0, n_chunks, [&](std::size_t lo, std::size_t hi, unsigned int) {
+            for (std::size_t c = lo; c < hi; ++c) {
+                const std::size_t first = base + c * chunk_records;
+                const std::size_t last = std::min(count, first + chunk_records);
+                for (std::size_t i = first; i < last; ++i) format(i, chunks[c]);
+                if (compressed) encoded[c] = out.encode(chunks[c].view());
+            }
+        }, threads);
+        for (std::size_t c = 0; c < n_chunks; ++c) {
+            if (compressed) {
+                out.write_encoded(encoded[c]);
+            } else {
+                out.write(chunks[c].view());
+            }
+            chunks[c].clear();
+        }
+    }
+}
+
+} // namespace io
+} // namespace tangle
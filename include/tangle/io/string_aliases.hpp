@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "tangle/graph.hpp"
+#include "tangle/perfect_hash.hpp"
+
+namespace tangle {
+namespace io {
+
+// Many-to-many mapping between STRING protein ids ("9606.ENSP00000000233")
+// and their aliases (UniProt accessions, gene symbols, Ensembl ids, ...),
+// loaded from a STRING `protein.aliases.txt` file.
+//
+// Ids and aliases are each stored once in a contiguous text table and
+// looked up through a minimal perfect hash; both directions of the mapping
+// are CSR index arrays. A protein's aliases keep their file order, so the
+// first one is the file's first match (STRING lists preferred names first).
+class StringAliases {
+public:
+    StringAliases() = default;
+
+    // Streams `filepath` (plain, gzip or zstd; columns string_protein_id,
+    // alias, source) in parallel blocks. Only rows whose space-separated
+    // source list contains one of `sources` (e.g. "UniProt_AC") are kept;
+    // empty keeps all. If `taxon` is set (e.g. "9606"), only proteins of
+    // that species are kept.
+    explicit StringAliases(const std::string& filepath, const std::vector<std::string>& sources = {},
+                           const std::string& taxon = "", unsigned int threads = 0);
+
+    std::size_t num_proteins() const { return id_offsets_.empty() ? 0 : id_offsets_.size() - 1; }
+    std::size_t num_aliases() const { return alias_offsets_.empty() ? 0 : alias_offsets_.size() - 1; }
+    std::size_t num_pairs() const { return id_aliases_.size(); }
+
+    // Aliases of a STRING id in file order, and STRING ids carrying an
+    // alias in sorted order. Views into the table; empty if unknown.
+    std::vector<std::string_view> aliases_of(std::string_view string_id) const;
+    std::vector<std::string_view> proteins_with(std::string_view alias) const;
+
+    // Bulk translation of a protein set. Each input contributes all of its
+    // mapped ids (or only the first with `first_only`) in input order;
+    // duplicates are dropped and unmapped inputs skipped. Sets of more than
+    // a thousand ids are looked up in parallel. The cost depends only on
+    // the set size, not the table size, so calling this once per community
+    // is cheap.
+    std::vector<ProteinId> to_aliases(const std::vector<ProteinId>& string_ids, bool first_only = false,
+                                      unsigned int threads = 0) const;
+    std::vector<ProteinId> to_string_ids(const std::vector<ProteinId>& aliases, bool first_only = false,
+                                         unsigned int threads = 0) const;
+
+    // Copy of `graph` with every node renamed to its first alias. Nodes
+    // that map to the same alias are merged (edges between them dropped);
+    // unmapped nodes keep their id, or are dropped with their edges if
+    // `keep_unmapped` is false. Gene symbols and edge weights are kept.
+    graph::PpiGraph relabel(const graph::PpiGraph& graph, bool keep_unmapped = true) const;
+
+private:
+    std::string id_text_;
+    std::vector<std::uint64_t> id_offsets_;
+    std::string alias_text_;
+    std::vector<std::uint64_t> alias_offsets_;
+
+    std::vector<std::uint32_t> id_alias_offsets_; // protein -> aliases, file order
+    std::vector<std::uint32_t> id_aliases_;
+    std::vector<std::uint32_t> alias_id_offsets_; // alias -> proteins, ascending
+    std::vector<std::uint32_t> alias_ids_;
+
+    PerfectHash id_hash_;
+    PerfectHash alias_hash_;
+
+    std::string_view id(std::uint32_t i) const {
+        return std::string_view(id_text_).substr(id_offsets_[i], id_offsets_[i + 1] - id_offsets_[i]);
+    }
+    std::string_view alias(std::uint32_t i) const {
+        return std::string_view(alias_text_).substr(alias_offsets_[i], alias_offsets_[i + 1] - alias_offsets_[i]);
+    }
+    // Table index, or uint32_t(-1) if absent.
+    std::uint32_t find_id(std::string_view string_id) const;
+    std::uint32_t find_alias(std::string_view alias) const;
+};
+
+} // namespace io
+} // namespace tangle
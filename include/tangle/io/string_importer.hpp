@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <string_view>
 #include "tangle/graph.hpp"
 
 namespace tangle {
@@ -20,5 +23,24 @@ namespace io {
 //                     Let's use a simpler approach for now.
 graph::PpiGraph load_from_string(const std::string& filepath, double min_score = 700.0, int score_column = 10, char delimiter = ' ');
 
+// Receives every STRING row that passes the score filter. The views are only
+// valid for the duration of the call.
+using StringEdgeSink =
+    std::function<void(std::string_view protein1, std::string_view protein2, double score)>;
+
+// Streams a STRING links file line by line, passing rows with a score of at
+// least `min_score` to `sink`. Nothing but the current line is kept, so
+// memory stays constant regardless of file size. Parsing follows
+// load_from_string (header skipped, short or unparsable rows ignored).
+// STRING lists every pair in both directions with the same score; if
+// `one_direction` is true only the row with protein1 < protein2 is kept.
+// That drops pairs listed only as protein1 > protein2, or whose mirror row
+// is unparsable or below `min_score`, so only use it on files known to be
+// symmetric.
+// Returns the number of rows passed to `sink`.
+std::size_t filter_string(const std::string& filepath, const StringEdgeSink& sink,
+                          double min_score = 700.0, int score_column = 10, char delimiter = ' ',
+                          bool one_direction = false);
+
 } // namespace io
 } // namespace tangle
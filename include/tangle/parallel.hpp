@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace tangle {
+namespace parallel {
+
+// Returns the number of worker threads used by tangle's parallel algorithms.
+// Falls back to 1 if the hardware concurrency cannot be determined.
+inline unsigned int num_threads() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Splits [begin, end) into one contiguous chunk per thread and calls
+// fn(chunk_begin, chunk_end, thread_index) on each chunk concurrently.
+// Useful for reductions where each thread keeps its own accumulator.
+// If `threads` is 0, num_threads() is used.
+template <typename Fn>
+void for_each_chunk(std::size_t begin, std::size_t end, Fn&& fn, unsigned int threads = 0) {
+    if (end <= begin) return;
+    if (threads == 0) threads = num_threads();
+    std::size_t n = end - begin;
+    threads = static_cast<unsigned int>(std::min<std::size_t>(threads, n));
+    if (threads <= 1) {
+        fn(begin, end, 0u);
+        return;
+    }
+
+    std::size_t chunk = (n + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned int t = 1; t < threads; ++t) {
+        std::size_t lo = begin + t * chunk;
+        std::size_t hi = std::min(end, lo + chunk);
+        if (lo >= hi) break;
+        workers.emplace_back([&fn, lo, hi, t]() { fn(lo, hi, t); });
+    }
+    fn(begin, std::min(end, begin + chunk), 0u);
+    for (auto& w : workers) w.join();
+}
+
+// Calls fn(i) for every i in [begin, end). Iterations are handed out in
+// blocks of `grain` from a shared counter, so skewed workloads (e.g. hub
+// nodes in a PPI network) stay balanced across threads.
+template <typename Fn>
+void parallel_for(std::size_t begin, std::size_t end, Fn&& fn,
+                  std::size_t grain = 256, unsigned int threads = 0) {
+    if (end <= begin) return;
+    if (threads == 0) threads = num_threads();
+    if (grain == 0) grain = 1;
+    std::size_t blocks = (end - begin + grain - 1) / grain;
+    threads = static_cast<unsigned int>(std::min<std::size_t>(threads, blocks));
+    if (threads <= 1) {
+        for (std::size_t i = begin; i < end; ++i) fn(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{begin};
+    auto worker = [&]() {
+        while (true) {
+            std::size_t lo = next.fetch_add(grain, std::memory_order_relaxed);
+            if (lo >= end) break;
+            std::size_t hi = std::min(end, lo + grain);
+            for (std::size_t i = lo; i < hi; ++i) fn(i);
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned int t = 1; t < threads; ++t) workers.emplace_back(worker);
+    worker();
+    for (auto& w : workers) w.join();
+}
+
+} // namespace parallel
+} // namespace tangle
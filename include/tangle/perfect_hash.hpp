@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace tangle {
+
+// Minimal perfect hash over a fixed set of distinct string keys
+// (hash-and-displace: keys are grouped into buckets and each bucket gets a
+// pilot value that sends all of its keys to free slots). A lookup costs one
+// string hash and two table reads, and the tables take 8 bytes per key.
+//
+// find() maps every key of the build set to its index in the vector passed
+// to the constructor. Any other key maps to some arbitrary index, so the
+// caller must compare against its own copy of the key.
+class PerfectHash {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    PerfectHash() = default;
+    explicit PerfectHash(const std::vector<std::string_view>& keys);
+
+    // Candidate index for `key`, or npos if the set is empty.
+    std::size_t find(std::string_view key) const;
+
+    // find() for keys[0..count), written to out[0..count). Hashes a batch
+    // first and prefetches its table entries, so the cache misses of
+    // independent lookups overlap.
+    void find_many(const std::string_view* keys, std::size_t count, std::size_t* out) const;
+
+    std::size_t size() const { return index_.size(); }
+
+    static std::uint64_t hash(std::string_view key);
+
+private:
+    std::vector<std::int32_t> pilots_; // per bucket; negative: -(slot + 1) for single-key buckets
+    std::vector<std::uint32_t> index_; // slot -> key index
+
+    std::size_t num_buckets() const { return pilots_.size(); }
+    std::size_t slot(std::uint64_t h, std::int32_t pilot) const;
+};
+
+} // namespace tangle
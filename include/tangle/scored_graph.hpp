@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "tangle/csr_graph.hpp"
+#include "tangle/graph.hpp"
+
+namespace tangle {
+namespace graph {
+
+// One network at every confidence threshold at once.
+// Edges (weights are scores, e.g. STRING combined scores) are canonicalized
+// and sorted by descending score, so the graph at any `min_score` is a
+// prefix of the edge array. Adjacency rows are sorted the same way, so a
+// node's neighbours above a threshold are a prefix of its row. Plain
+// CsrGraph views for existing algorithms are built on first use per
+// threshold and cached.
+//
+// Load once at the lowest threshold of interest (e.g. 400) and serve 400,
+// 700 and 900 from the same store instead of re-importing per threshold.
+class ScoredGraphStore {
+public:
+    // Duplicate edges keep their highest score.
+    explicit ScoredGraphStore(const PpiGraph& graph, unsigned int threads = 0);
+
+    std::size_t num_nodes() const { return nodes_.size(); }
+    const std::vector<Node>& nodes() const { return nodes_; }
+
+    // Edges with score >= min_score, highest score first.
+    Range<Edge> edges(double min_score) const;
+    std::size_t num_edges(double min_score) const { return edges(min_score).size(); }
+
+    // Neighbours of v reached with score >= min_score, highest score first,
+    // and their scores.
+    NeighborRange neighbors(NodeId v, double min_score) const;
+    WeightRange neighbor_scores(NodeId v, double min_score) const;
+
+    // Sorted, deduplicated CSR of the graph at min_score. Built on the first
+    // request for a threshold and reused afterwards; thread-safe.
+    const CsrGraph& csr(double min_score) const;
+
+    // The graph at min_score as a PpiGraph with the full node table.
+    PpiGraph subgraph(double min_score) const;
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_;         // descending score
+    std::vector<EdgeId> offsets_;     // score-sorted adjacency
+    std::vector<NodeId> targets_;
+    std::vector<Weight> scores_;
+
+    mutable std::mutex cache_mutex_;
+    mutable std::map<double, std::unique_ptr<CsrGraph>> csr_cache_;
+
+    // Length of the prefix of a descending-score array with score >= min_score.
+    static std::size_t cutoff(const Weight* first, const Weight* last, double min_score);
+};
+
+} // namespace graph
+} // namespace tangle
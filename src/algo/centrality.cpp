@@ -20,5 +20,18 @@ std::vector<double> degree_centrality(const graph::PpiGraph& graph, bool use_wei
     return degrees;
 }
 
+std::vector<double> degree_centrality(const io::EdgeStream& edges, bool use_weights) {
+    std::vector<double> degrees(edges.num_nodes(), 0.0);
+    edges.for_each_edge([&](const graph::Edge& e) {
+        if (e.u >= degrees.size() || e.v >= degrees.size()) {
+            throw std::out_of_range("NodeId out of range in edge file");
+        }
+        Weight w = use_weights ? e.weight : 1.0;
+        degrees[e.u] += w;
+        degrees[e.v] += w;
+    });
+    return degrees;
+}
+
 } // namespace algo
 } // namespace tangle
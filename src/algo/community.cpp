@@ -1,10 +1,13 @@
 #include "tangle/algo/community.hpp"
+#include "tangle/algo/components.hpp"
+#include "tangle/parallel.hpp"
 #include <numeric>
 #include <algorithm>
-#include <map>
+#include <atomic>
+#include <utility>
 #include <vector>
 #include <random>
-#include <set>
+#include <stdexcept>
 
 namespace tangle {
 namespace algo {
@@ -12,137 +15,496 @@ namespace algo {
 // A more robust implementation of the Louvain method, guided by best practices.
 // This version focuses on a correct Phase 1 implementation.
 
-// Helper to calculate modularity gain. This is a critical part.
-// ΔQ = [ (k_i_in / 2m) - ( (Σ_tot * k_i) / (2m)^2 ) ]
-// We calculate the gain of moving node `u` into community `C`.
-double calculate_modularity_gain(
-    NodeId u,
-    NodeId target_community_id,
-    double k_i, // degree of node u
-    const std::vector<NodeId>& communities,
-    const std::vector<double>& community_total_degrees, // Σ_tot for each community
-    const graph::PpiGraph& graph,
-    double m // total number of edges
-) {
-    double k_i_in = 0.0;
-    for (const auto& neighbor : graph.neighbors(u)) {
-        if (communities[neighbor] == target_community_id) {
-            k_i_in += 1.0; // Assuming unweighted for now.
-        }
+namespace {
+
+// Moves smaller than this are treated as ties, so floating-point noise
+// cannot make two communities trade a node back and forth forever.
+constexpr double kMinGain = 1e-12;
+
+// Nodes per batch of a multi-threaded sweep. Fixed, so the partition does
+// not depend on how many threads share the batch.
+constexpr std::size_t kMoveBatch = 4096;
+
+// Fewest resolutions per chain of a sweep; shorter chains lose most of the
+// warm start, so spare threads go into each Louvain run instead.
+constexpr std::size_t kMinChainLength = 4;
+
+// Relabels communities densely in order of their smallest NodeId.
+std::vector<NodeId> normalize_labels(const std::vector<NodeId>& labels) {
+    NodeId max_label = 0;
+    for (NodeId l : labels) max_label = std::max(max_label, l);
+    std::vector<NodeId> remap(labels.empty() ? 0 : std::size_t(max_label) + 1, static_cast<NodeId>(-1));
+    std::vector<NodeId> result(labels.size());
+    NodeId next = 0;
+    for (std::size_t v = 0; v < labels.size(); ++v) {
+        NodeId& r = remap[labels[v]];
+        if (r == static_cast<NodeId>(-1)) r = next++;
+        result[v] = r;
     }
-    
-    double sigma_tot = community_total_degrees.at(target_community_id);
-    double delta_q = k_i_in - (sigma_tot * k_i) / (2.0 * m);
-    return delta_q;
+    return result;
 }
 
-std::vector<std::vector<NodeId>> louvain_community(const graph::PpiGraph& graph, bool use_weights) {
-    if (graph.num_nodes() == 0) {
-        return {};
+// Degree of every node (weighted or edge count) in the CSR graph.
+double node_degree(const graph::CsrGraph& graph, NodeId u, bool use_weights) {
+    if (!use_weights) return static_cast<double>(graph.degree(u));
+    double k = 0.0;
+    for (Weight w : graph.neighbor_weights(u)) k += w;
+    return k;
+}
+
+// The Phase 1 move: takes a node out of its community and puts it into the
+// neighbouring community with the best modularity gain. Shared by the full
+// sweeps of louvain_membership and the localized updates of DynamicLouvain.
+class LocalMover {
+public:
+    LocalMover(const graph::CsrGraph& graph, bool use_weights, double resolution, double two_m,
+               const std::vector<double>& node_degrees, std::vector<double>& community_total_degrees,
+               std::vector<NodeId>& communities)
+        : graph_(graph), use_weights_(use_weights), resolution_(resolution), two_m_(two_m),
+          node_degrees_(node_degrees), community_total_degrees_(community_total_degrees),
+          communities_(communities), neighbor_weight_(community_total_degrees.size(), -1.0) {}
+
+    // Returns true if u changed community.
+    bool move(NodeId u) {
+        NodeId original_community = communities_[u];
+        double k_i = node_degrees_[u];
+
+        // k_i_in for every neighbouring community
+        auto nbrs = graph_.neighbors(u);
+        auto wts = graph_.neighbor_weights(u);
+        for (std::size_t i = 0; i < nbrs.size(); ++i) {
+            NodeId c = communities_[nbrs[i]];
+            if (neighbor_weight_[c] < 0.0) {
+                neighbor_weight_[c] = 0.0;
+                neighbor_communities_.push_back(c);
+            }
+            neighbor_weight_[c] += use_weights_ ? wts[i] : 1.0;
+        }
+
+        // Take u out of its community, then compare every candidate,
+        // including putting it back, with the same formula:
+        // ΔQ ∝ k_i_in - γ * Σ_tot * k_i / 2m
+        community_total_degrees_[original_community] -= k_i;
+        double own_in = std::max(0.0, neighbor_weight_[original_community]);
+        double max_gain =
+            own_in - resolution_ * community_total_degrees_[original_community] * k_i / two_m_;
+        NodeId best_community = original_community;
+
+        for (NodeId target_community : neighbor_communities_) {
+            if (target_community == original_community) continue;
+            double gain = neighbor_weight_[target_community] -
+                          resolution_ * community_total_degrees_[target_community] * k_i / two_m_;
+            if (gain > max_gain + kMinGain) {
+                max_gain = gain;
+                best_community = target_community;
+            }
+        }
+
+        community_total_degrees_[best_community] += k_i;
+        communities_[u] = best_community;
+
+        for (NodeId c : neighbor_communities_) neighbor_weight_[c] = -1.0;
+        neighbor_communities_.clear();
+        return best_community != original_community;
+    }
+
+private:
+    const graph::CsrGraph& graph_;
+    bool use_weights_;
+    double resolution_;
+    double two_m_;
+    const std::vector<double>& node_degrees_;
+    std::vector<double>& community_total_degrees_;
+    std::vector<NodeId>& communities_;
+
+    // Scratch space: weight from the current node to each neighbouring
+    // community (-1 = not a neighbour), plus the list of touched communities.
+    std::vector<double> neighbor_weight_;
+    std::vector<NodeId> neighbor_communities_;
+};
+
+// Whether LocalMover::move would take u out of its community, judged
+// read-only against the current partition so that many nodes can be
+// checked at once. `scratch` holds (community, weight) pairs per thread.
+bool wants_move(const graph::CsrGraph& graph, NodeId u, bool use_weights, double resolution,
+                double two_m, const std::vector<double>& node_degrees,
+                const std::vector<double>& community_total_degrees,
+                const std::vector<NodeId>& communities,
+                std::vector<std::pair<NodeId, double>>& scratch) {
+    scratch.clear();
+    auto nbrs = graph.neighbors(u);
+    auto wts = graph.neighbor_weights(u);
+    for (std::size_t i = 0; i < nbrs.size(); ++i) {
+        scratch.emplace_back(communities[nbrs[i]], use_weights ? wts[i] : 1.0);
+    }
+    // Stable, so each community's weights are summed in neighbour order as in move().
+    std::stable_sort(scratch.begin(), scratch.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::size_t groups = 0;
+    for (const auto& entry : scratch) {
+        if (groups > 0 && scratch[groups - 1].first == entry.first) {
+            scratch[groups - 1].second += entry.second;
+        } else {
+            scratch[groups++] = entry;
+        }
+    }
+    scratch.resize(groups);
+
+    const NodeId own = communities[u];
+    const double k_i = node_degrees[u];
+    double own_in = 0.0;
+    for (const auto& entry : scratch) {
+        if (entry.first == own) own_in = entry.second;
+    }
+    const double stay = own_in - resolution * (community_total_degrees[own] - k_i) * k_i / two_m;
+    for (const auto& entry : scratch) {
+        if (entry.first == own) continue;
+        double gain = entry.second - resolution * community_total_degrees[entry.first] * k_i / two_m;
+        if (gain > stay + kMinGain) return true;
     }
+    return false;
+}
+
+} // namespace
+
+std::vector<NodeId> louvain_membership(const graph::CsrGraph& graph, bool use_weights,
+                                       std::uint64_t seed, double resolution,
+                                       const std::vector<NodeId>& initial, unsigned int threads) {
+    const std::size_t n = graph.num_nodes();
 
     // --- Initialization ---
     // communities[i] = community ID of node i
-    std::vector<NodeId> communities(graph.num_nodes());
-    std::iota(communities.begin(), communities.end(), 0); 
+    std::vector<NodeId> communities(n);
+    if (initial.empty()) {
+        std::iota(communities.begin(), communities.end(), 0);
+    } else {
+        if (initial.size() != n) {
+            throw std::invalid_argument("Initial membership size does not match node count");
+        }
+        for (NodeId v = 0; v < n; ++v) {
+            if (initial[v] >= n) {
+                throw std::out_of_range("Initial community label out of range");
+            }
+            communities[v] = initial[v];
+        }
+    }
 
-    std::vector<double> node_degrees(graph.num_nodes());
-    double m = 0.0; // Total number of edges (sum of weights / 2)
+    std::vector<double> node_degrees(n, 0.0);
+    double two_m = 0.0; // 2m: sum of all node degrees
+    for (NodeId u = 0; u < n; ++u) {
+        node_degrees[u] = node_degree(graph, u, use_weights);
+        two_m += node_degrees[u];
+    }
 
-    for (const auto& edge : graph.edges()) {
-        double weight = use_weights ? edge.weight : 1.0;
-        node_degrees[edge.u] += weight;
-        node_degrees[edge.v] += weight;
-        m += weight;
+    if (two_m == 0.0) { // No edges
+        return normalize_labels(communities);
     }
-    m /= 2.0;
 
-    if (m == 0.0) { // No edges
-        std::vector<std::vector<NodeId>> result;
-        for(NodeId i = 0; i < graph.num_nodes(); ++i) result.push_back({i});
-        return result;
+    // Σ_tot for each community, updated incrementally as nodes move.
+    std::vector<double> community_total_degrees(n, 0.0);
+    for (NodeId v = 0; v < n; ++v) {
+        community_total_degrees[communities[v]] += node_degrees[v];
     }
 
+    LocalMover mover(graph, use_weights, resolution, two_m, node_degrees,
+                     community_total_degrees, communities);
+
+    std::vector<NodeId> node_order(n);
+    std::iota(node_order.begin(), node_order.end(), 0);
+    std::mt19937_64 g(seed);
+
+    // With several threads, each batch of the shuffled order is first
+    // checked in parallel against the partition at the start of the batch;
+    // only nodes that want to leave are then moved, in order. Nodes skipped
+    // because an earlier move in the batch changed their gain are picked up
+    // by the next sweep.
+    if (threads == 0) threads = parallel::num_threads();
+    const bool batched = threads > 1 && n > kMoveBatch;
+    std::vector<std::vector<std::pair<NodeId, double>>> scratch(batched ? threads : 0);
+    std::vector<char> proposed(batched ? kMoveBatch : 0);
+
     // --- Main Loop: Repeat until no more improvement ---
     bool improvement = true;
     while (improvement) {
         improvement = false;
 
         // --- Phase 1: Modularity Optimization ---
-        
+
         // Randomize node order to avoid getting stuck
-        std::vector<NodeId> node_order(graph.num_nodes());
-        std::iota(node_order.begin(), node_order.end(), 0);
-        std::random_device rd;
-        std::mt19937 g(rd());
         std::shuffle(node_order.begin(), node_order.end(), g);
-        
-        for (NodeId u : node_order) {
-            NodeId original_community = communities[u];
-            NodeId best_community = original_community;
-            double max_gain = 0.0;
-
-            // Calculate sum of degrees for each community
-            std::map<NodeId, double> community_degrees_map;
-            for(size_t i=0; i<graph.num_nodes(); ++i){
-                community_degrees_map[communities[i]] += node_degrees[i];
-            }
 
-            // Consider moving to neighbor communities
-            std::set<NodeId> neighbor_communities;
-            for (const auto& neighbor : graph.neighbors(u)) {
-                neighbor_communities.insert(communities[neighbor]);
+        if (!batched) {
+            for (NodeId u : node_order) {
+                if (mover.move(u)) {
+                    improvement = true;
+                }
             }
+            continue;
+        }
 
-            for (NodeId target_community : neighbor_communities) {
-                if (target_community == original_community) continue;
-                
-                // Calculate modularity gain for moving u to target_community
-                double k_i_in = 0.0;
-                for (const auto& neighbor : graph.neighbors(u)) {
-                    if (communities[neighbor] == target_community) {
-                        k_i_in += 1.0; // unweighted for now
-                    }
+        for (std::size_t lo = 0; lo < n; lo += kMoveBatch) {
+            const std::size_t hi = std::min(n, lo + kMoveBatch);
+            parallel::for_each_chunk(lo, hi, [&](std::size_t begin, std::size_t end, unsigned int t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    proposed[i - lo] = wants_move(graph, node_order[i], use_weights, resolution, two_m,
+                                                  node_degrees, community_total_degrees, communities,
+                                                  scratch[t]);
                 }
-                
-                double sigma_tot = community_degrees_map[target_community];
-                double k_i = node_degrees[u];
-                
-                double gain = k_i_in - (sigma_tot * k_i) / (2.0 * m);
-
-                if (gain > max_gain) {
-                    max_gain = gain;
-                    best_community = target_community;
+            }, threads);
+            for (std::size_t i = lo; i < hi; ++i) {
+                if (proposed[i - lo] && mover.move(node_order[i])) {
+                    improvement = true;
                 }
             }
-
-            // If a move is beneficial, make it
-            if (best_community != original_community) {
-                // Move node u to the best community
-                communities[u] = best_community;
-                improvement = true;
-            }
         }
     }
-    
+
     // --- Phase 2: Community Aggregation (simplified for now) ---
     // The current implementation only performs one level of community detection.
     // A full implementation would create a new graph where communities are nodes
     // and repeat the process. We will stick to one level for this version.
+    return normalize_labels(communities);
+}
+
+DynamicLouvain::DynamicLouvain(const graph::CsrGraph& graph, const std::vector<NodeId>& membership,
+                               bool use_weights, double resolution)
+    : use_weights_(use_weights), resolution_(resolution) {
+    const std::size_t n = graph.num_nodes();
+    if (membership.size() != n) {
+        throw std::invalid_argument("Membership size does not match node count");
+    }
+    communities_ = normalize_labels(membership);
+    node_degrees_.resize(n);
+    community_total_degrees_.assign(n, 0.0);
+    for (NodeId v = 0; v < n; ++v) {
+        node_degrees_[v] = node_degree(graph, v, use_weights_);
+        community_total_degrees_[communities_[v]] += node_degrees_[v];
+        two_m_ += node_degrees_[v];
+    }
+}
+
+std::size_t DynamicLouvain::update(const graph::CsrGraph& graph, const std::vector<graph::Edge>& added,
+                                   const std::vector<graph::Edge>& removed) {
+    const std::size_t old_n = communities_.size();
+    const std::size_t n = graph.num_nodes();
+    if (n < old_n) {
+        throw std::invalid_argument("DynamicLouvain::update: nodes cannot be removed");
+    }
 
-    // Map communities to a dense set of community IDs
-    std::map<NodeId, std::vector<NodeId>> community_map;
-    for (size_t i = 0; i < communities.size(); ++i) {
-        community_map[communities[i]].push_back(i);
+    // New nodes join as singletons with fresh labels.
+    for (std::size_t v = old_n; v < n; ++v) {
+        communities_.push_back(static_cast<NodeId>(community_total_degrees_.size()));
+        community_total_degrees_.push_back(0.0);
+        node_degrees_.push_back(0.0);
     }
-    
+
+    // Endpoints of changed edges, plus every new node.
+    std::vector<char> queued(n, 0);
+    std::vector<NodeId> touched;
+    auto touch = [&](NodeId v) {
+        if (v >= n) throw std::out_of_range("NodeId out of range in DynamicLouvain::update");
+        if (!queued[v]) {
+            queued[v] = 1;
+            touched.push_back(v);
+        }
+    };
+    for (const auto& e : added) { touch(e.u); touch(e.v); }
+    for (const auto& e : removed) { touch(e.u); touch(e.v); }
+    for (std::size_t v = old_n; v < n; ++v) touch(static_cast<NodeId>(v));
+
+    // Refresh degrees of the touched nodes only and shift Σ_tot and 2m by the difference.
+    for (NodeId v : touched) {
+        double k = node_degree(graph, v, use_weights_);
+        double delta = k - node_degrees_[v];
+        node_degrees_[v] = k;
+        community_total_degrees_[communities_[v]] += delta;
+        two_m_ += delta;
+    }
+    if (two_m_ <= 0.0) return 0;
+
+    // Seed the work queue with the touched nodes and their neighbourhoods.
+    std::vector<NodeId> queue = touched;
+    for (NodeId v : touched) {
+        for (NodeId u : graph.neighbors(v)) {
+            if (!queued[u]) {
+                queued[u] = 1;
+                queue.push_back(u);
+            }
+        }
+    }
+
+    LocalMover mover(graph, use_weights_, resolution_, two_m_, node_degrees_,
+                     community_total_degrees_, communities_);
+    std::size_t evaluated = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        NodeId u = queue[head];
+        queued[u] = 0;
+        ++evaluated;
+        if (mover.move(u)) {
+            // A move changes the gains of u's neighbours; revisit them.
+            for (NodeId v : graph.neighbors(u)) {
+                if (!queued[v]) {
+                    queued[v] = 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+    }
+    return evaluated;
+}
+
+std::vector<NodeId> DynamicLouvain::membership() const {
+    return normalize_labels(communities_);
+}
+
+std::vector<std::vector<NodeId>> communities_from_membership(const std::vector<NodeId>& membership) {
     std::vector<std::vector<NodeId>> result;
-    for (auto const& [key, val] : community_map) {
-        result.push_back(val);
+    for (NodeId v = 0; v < membership.size(); ++v) {
+        if (membership[v] >= result.size()) result.resize(membership[v] + 1);
+        result[membership[v]].push_back(v);
     }
-    
     return result;
 }
 
+std::vector<NodeId> membership_from_communities(const std::vector<std::vector<NodeId>>& communities,
+                                                std::size_t num_nodes) {
+    const NodeId unassigned = static_cast<NodeId>(-1);
+    std::vector<NodeId> membership(num_nodes, unassigned);
+    for (NodeId c = 0; c < communities.size(); ++c) {
+        for (NodeId v : communities[c]) {
+            if (v >= num_nodes) {
+                throw std::out_of_range("NodeId out of range in membership_from_communities");
+            }
+            membership[v] = c;
+        }
+    }
+    NodeId next = static_cast<NodeId>(communities.size());
+    for (auto& label : membership) {
+        if (label == unassigned) label = next++;
+    }
+    return membership;
+}
+
+std::vector<std::vector<NodeId>> louvain_community(const graph::PpiGraph& graph, bool use_weights,
+                                                   double resolution) {
+    if (graph.num_nodes() == 0) {
+        return {};
+    }
+    std::random_device rd;
+    graph::CsrGraph csr(graph);
+    return communities_from_membership(louvain_membership(csr, use_weights, rd(), resolution));
+}
+
+ResolutionSweep resolution_sweep(const graph::CsrGraph& graph,
+                                 const std::vector<double>& resolutions,
+                                 bool use_weights, std::uint64_t seed,
+                                 unsigned int threads) {
+    const std::size_t n = graph.num_nodes();
+    const std::size_t count = resolutions.size();
+    ResolutionSweep sweep;
+    sweep.resolutions = resolutions;
+    sweep.num_nodes = n;
+    sweep.num_communities.assign(count, 0);
+    sweep.membership.assign(count * n, 0);
+    if (count == 0) return sweep;
+
+    // Process from fine (large γ) to coarse (small γ).
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return resolutions[a] > resolutions[b];
+    });
+
+    if (threads == 0) threads = parallel::num_threads();
+    std::size_t chains = std::min<std::size_t>(threads, std::max<std::size_t>(1, count / kMinChainLength));
+    std::size_t chain_len = (count + chains - 1) / chains;
+
+    parallel::parallel_for(0, chains, [&](std::size_t c) {
+        std::size_t lo = c * chain_len;
+        std::size_t hi = std::min(count, lo + chain_len);
+        // Threads left over beyond one per chain go into the runs.
+        unsigned int run_threads = static_cast<unsigned int>(threads / chains + (c < threads % chains ? 1 : 0));
+        std::vector<NodeId> previous; // empty = cold start
+        for (std::size_t k = lo; k < hi; ++k) {
+            std::size_t r = order[k];
+            previous = louvain_membership(graph, use_weights, seed + r, resolutions[r], previous,
+                                          run_threads);
+            std::copy(previous.begin(), previous.end(), sweep.membership.begin() + r * n);
+            NodeId max_label = 0;
+            for (NodeId l : previous) max_label = std::max(max_label, l);
+            sweep.num_communities[r] = n == 0 ? 0 : max_label + 1;
+        }
+    }, 1, static_cast<unsigned int>(chains));
+    return sweep;
+}
+
+std::vector<std::vector<NodeId>> consensus_communities(const graph::PpiGraph& graph,
+                                                       std::size_t runs,
+                                                       bool use_weights,
+                                                       double threshold,
+                                                       std::uint64_t seed,
+                                                       std::size_t max_iterations,
+                                                       unsigned int threads) {
+    const std::size_t n = graph.num_nodes();
+    if (n == 0) {
+        return {};
+    }
+    if (runs == 0) runs = 1;
+
+    // One entry per undirected edge of the simple graph; the weight is the
+    // edge weight in the first round and the agreement fraction afterwards.
+    std::vector<graph::Edge> edges;
+    {
+        graph::CsrGraph csr(graph);
+        for (NodeId u = 0; u < n; ++u) {
+            auto nbrs = csr.neighbors(u);
+            auto wts = csr.neighbor_weights(u);
+            for (std::size_t i = 0; i < nbrs.size(); ++i) {
+                if (u < nbrs[i]) {
+                    edges.push_back(graph::Edge{u, nbrs[i], use_weights ? wts[i] : 1.0});
+                }
+            }
+        }
+    }
+
+    std::vector<graph::Edge> agreed;
+    for (std::size_t iter = 0; iter < max_iterations && !edges.empty(); ++iter) {
+        graph::CsrGraph csr(n, edges);
+
+        // Co-assignment counts restricted to existing edges: O(E) memory,
+        // O(E * R) work, accumulated as each run finishes.
+        std::vector<std::atomic<std::uint32_t>> together(edges.size());
+        for (auto& t : together) t.store(0, std::memory_order_relaxed);
+
+        parallel::parallel_for(0, runs, [&](std::size_t r) {
+            std::vector<NodeId> labels = louvain_membership(csr, true, seed + iter * runs + r);
+            for (std::size_t e = 0; e < edges.size(); ++e) {
+                if (labels[edges[e].u] == labels[edges[e].v]) {
+                    together[e].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }, 1, threads);
+
+        bool stable = true;
+        std::vector<graph::Edge> next;
+        agreed.clear();
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            std::uint32_t t = together[e].load(std::memory_order_relaxed);
+            double fraction = static_cast<double>(t) / static_cast<double>(runs);
+            if (t != 0 && t != runs) stable = false;
+            if (fraction >= threshold && t != 0) {
+                next.push_back(graph::Edge{edges[e].u, edges[e].v, fraction});
+            }
+            if (t == runs) agreed.push_back(edges[e]);
+        }
+
+        if (stable) break;
+        edges = std::move(next);
+        agreed = edges; // best available consensus if we run out of iterations
+    }
+
+    return communities_from_membership(connected_components(n, agreed, threads));
+}
+
 } // namespace algo
-} // namespace tangle
\ No newline at end of file
+} // namespace tangle
@@ -0,0 +1,182 @@
+#include "tangle/algo/components.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace tangle {
+namespace algo {
+
+namespace {
+
+// Follows parent pointers to the root, halving the path on the way.
+// Parents only ever decrease, so a stale CAS is harmless.
+NodeId find_root(std::vector<std::atomic<NodeId>>& parent, NodeId x) {
+    while (true) {
+        NodeId p = parent[x].load(std::memory_order_relaxed);
+        if (p == x) return x;
+        NodeId gp = parent[p].load(std::memory_order_relaxed);
+        if (p != gp) {
+            parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        }
+        x = gp;
+    }
+}
+
+void unite(std::vector<std::atomic<NodeId>>& parent, NodeId u, NodeId v) {
+    while (true) {
+        NodeId ru = find_root(parent, u);
+        NodeId rv = find_root(parent, v);
+        if (ru == rv) return;
+        NodeId hi = std::max(ru, rv);
+        NodeId lo = std::min(ru, rv);
+        // Succeeds only if `hi` is still a root; otherwise retry from the new roots.
+        NodeId expected = hi;
+        if (parent[hi].compare_exchange_strong(expected, lo, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+// Every root is the smallest NodeId of its tree, so a single ordered pass
+// assigns dense ids in order of each component's smallest node.
+std::vector<NodeId> dense_labels(std::vector<std::atomic<NodeId>>& parent) {
+    std::vector<NodeId> labels(parent.size());
+    NodeId next_label = 0;
+    for (NodeId v = 0; v < parent.size(); ++v) {
+        NodeId r = find_root(parent, v);
+        labels[v] = (r == v) ? next_label++ : labels[r];
+    }
+    return labels;
+}
+
+} // namespace
+
+std::vector<NodeId> connected_components(const graph::PpiGraph& graph,
+                                         unsigned int threads) {
+    return connected_components(graph.num_nodes(), graph.edges(), threads);
+}
+
+std::vector<NodeId> connected_components(std::size_t n,
+                                         const std::vector<graph::Edge>& edges,
+                                         unsigned int threads) {
+    for (const auto& e : edges) {
+        if (e.u >= n || e.v >= n) {
+            throw std::out_of_range("NodeId out of range in connected_components");
+        }
+    }
+    std::vector<std::atomic<NodeId>> parent(n);
+    for (NodeId v = 0; v < n; ++v) parent[v].store(v, std::memory_order_relaxed);
+
+    parallel::parallel_for(0, edges.size(), [&](std::size_t i) {
+        unite(parent, edges[i].u, edges[i].v);
+    }, 4096, threads);
+
+    return dense_labels(parent);
+}
+
+std::vector<NodeId> connected_components(const io::EdgeStream& edges, unsigned int threads) {
+    const std::size_t n = edges.num_nodes();
+    std::vector<std::atomic<NodeId>> parent(n);
+    for (NodeId v = 0; v < n; ++v) parent[v].store(v, std::memory_order_relaxed);
+
+    edges.for_each_batch([&](const graph::Edge* batch, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (batch[i].u >= n || batch[i].v >= n) {
+                throw std::out_of_range("NodeId out of range in edge file");
+            }
+        }
+        parallel::parallel_for(0, count, [&](std::size_t i) {
+            unite(parent, batch[i].u, batch[i].v);
+        }, 4096, threads);
+    });
+
+    return dense_labels(parent);
+}
+
+std::vector<NodeId> connected_components(const graph::CompressedCsrGraph& graph,
+                                         unsigned int threads) {
+    const std::size_t n = graph.num_nodes();
+    std::vector<std::atomic<NodeId>> parent(n);
+    for (NodeId v = 0; v < n; ++v) parent[v].store(v, std::memory_order_relaxed);
+
+    parallel::parallel_for(0, n, [&](std::size_t v) {
+        for (NodeId u : graph.neighbors(static_cast<NodeId>(v))) {
+            if (u > v) unite(parent, static_cast<NodeId>(v), u);
+        }
+    }, 256, threads);
+
+    return dense_labels(parent);
+}
+
+std::vector<NodeId> connected_components(const graph::GraphOverlay& graph) {
+    const std::size_t n = graph.num_nodes();
+    constexpr NodeId kUnlabelled = static_cast<NodeId>(-1);
+    std::vector<NodeId> labels(n, kUnlabelled);
+    std::vector<NodeId> queue;
+    NodeId next = 0;
+    for (NodeId s = 0; s < n; ++s) {
+        if (labels[s] != kUnlabelled) continue;
+        labels[s] = next;
+        queue.assign(1, s);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            graph.for_each_neighbor(queue[head], [&](NodeId u, Weight) {
+                if (labels[u] == kUnlabelled) {
+                    labels[u] = next;
+                    queue.push_back(u);
+                }
+            });
+        }
+        ++next;
+    }
+    return labels;
+}
+
+std::vector<KnockoutImpact> knockout_impact(const graph::CsrGraph& graph,
+                                            const std::vector<NodeId>& nodes,
+                                            unsigned int threads) {
+    for (NodeId v : nodes) {
+        if (v >= graph.num_nodes()) {
+            throw std::out_of_range("NodeId out of range in knockout_impact");
+        }
+    }
+    std::vector<KnockoutImpact> result(nodes.size());
+    parallel::parallel_for(0, nodes.size(), [&](std::size_t i) {
+        graph::GraphOverlay overlay(graph);
+        overlay.remove_node(nodes[i]);
+        auto labels = connected_components(overlay);
+        auto sizes = component_sizes(labels);
+        // The knocked-out node remains as an isolated id; leave it out.
+        sizes[labels[nodes[i]]] = 0;
+        KnockoutImpact& impact = result[i];
+        impact.num_components = sizes.size() - 1;
+        impact.largest_component = sizes.empty() ? 0 : *std::max_element(sizes.begin(), sizes.end());
+    }, 1, threads);
+    return result;
+}
+
+std::vector<std::size_t> component_sizes(const std::vector<NodeId>& labels) {
+    std::vector<std::size_t> sizes;
+    for (NodeId c : labels) {
+        if (c >= sizes.size()) sizes.resize(c + 1, 0);
+        sizes[c]++;
+    }
+    return sizes;
+}
+
+graph::PpiGraph largest_component(const graph::PpiGraph& graph, unsigned int threads) {
+    std::vector<NodeId> labels = connected_components(graph, threads);
+    std::vector<std::size_t> sizes = component_sizes(labels);
+    if (sizes.empty()) return graph::PpiGraph();
+
+    NodeId largest = static_cast<NodeId>(
+        std::max_element(sizes.begin(), sizes.end()) - sizes.begin());
+    std::vector<bool> keep(graph.num_nodes());
+    for (NodeId v = 0; v < graph.num_nodes(); ++v) {
+        keep[v] = labels[v] == largest;
+    }
+    return graph::induced_subgraph(graph, keep);
+}
+
+} // namespace algo
+} // namespace tangle
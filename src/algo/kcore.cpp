@@ -0,0 +1,145 @@
+#include "tangle/algo/kcore.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace tangle {
+namespace algo {
+
+std::vector<std::uint32_t> core_numbers(const graph::PpiGraph& graph) {
+    const std::size_t n = graph.num_nodes();
+    std::vector<std::uint32_t> deg(n);
+    std::uint32_t max_deg = 0;
+    for (NodeId v = 0; v < n; ++v) {
+        deg[v] = static_cast<std::uint32_t>(graph.neighbors(v).size());
+        max_deg = std::max(max_deg, deg[v]);
+    }
+
+    // Bucket sort the nodes by degree.
+    // bin[d] = start position of the degree-d block in `vert`.
+    std::vector<std::size_t> bin(max_deg + 1, 0);
+    for (NodeId v = 0; v < n; ++v) bin[deg[v]]++;
+    std::size_t start = 0;
+    for (std::uint32_t d = 0; d <= max_deg; ++d) {
+        std::size_t count = bin[d];
+        bin[d] = start;
+        start += count;
+    }
+
+    std::vector<NodeId> vert(n);
+    std::vector<std::size_t> pos(n);
+    for (NodeId v = 0; v < n; ++v) {
+        pos[v] = bin[deg[v]]++;
+        vert[pos[v]] = v;
+    }
+    for (std::uint32_t d = max_deg; d > 0; --d) bin[d] = bin[d - 1];
+    if (!bin.empty()) bin[0] = 0;
+
+    // Peel in degree order. When a neighbour's degree drops, it is swapped to
+    // the front of its bucket and the bucket boundary moves up by one.
+    for (std::size_t i = 0; i < n; ++i) {
+        NodeId v = vert[i];
+        for (NodeId u : graph.neighbors(v)) {
+            if (deg[u] > deg[v]) {
+                std::uint32_t du = deg[u];
+                std::size_t pu = pos[u];
+                std::size_t pw = bin[du];
+                NodeId w = vert[pw];
+                if (u != w) {
+                    pos[u] = pw;
+                    vert[pu] = w;
+                    pos[w] = pu;
+                    vert[pw] = u;
+                }
+                bin[du]++;
+                deg[u]--;
+            }
+        }
+    }
+    return deg;
+}
+
+std::vector<std::uint32_t> core_numbers_parallel(const graph::PpiGraph& graph,
+                                                 unsigned int threads) {
+    const std::size_t n = graph.num_nodes();
+    std::vector<std::uint32_t> core(n, 0);
+    if (n == 0) return core;
+    if (threads == 0) threads = parallel::num_threads();
+
+    std::vector<std::atomic<std::uint32_t>> deg(n);
+    std::vector<std::atomic<bool>> removed(n);
+    for (NodeId v = 0; v < n; ++v) {
+        deg[v].store(static_cast<std::uint32_t>(graph.neighbors(v).size()),
+                     std::memory_order_relaxed);
+        removed[v].store(false, std::memory_order_relaxed);
+    }
+
+    std::size_t remaining = n;
+    std::uint32_t k = 0;
+    std::mutex merge_mtx;
+
+    while (remaining > 0) {
+        // Seed the k-shell with every remaining node whose degree is already <= k.
+        std::vector<NodeId> frontier;
+        std::uint32_t min_deg = UINT32_MAX;
+        parallel::for_each_chunk(0, n, [&](std::size_t lo, std::size_t hi, unsigned int) {
+            std::vector<NodeId> local;
+            std::uint32_t local_min = UINT32_MAX;
+            for (std::size_t v = lo; v < hi; ++v) {
+                if (removed[v].load(std::memory_order_relaxed)) continue;
+                std::uint32_t d = deg[v].load(std::memory_order_relaxed);
+                if (d <= k) local.push_back(static_cast<NodeId>(v));
+                else local_min = std::min(local_min, d);
+            }
+            std::lock_guard<std::mutex> lock(merge_mtx);
+            frontier.insert(frontier.end(), local.begin(), local.end());
+            min_deg = std::min(min_deg, local_min);
+        }, threads);
+
+        if (frontier.empty()) {
+            // Nothing left at this level: jump straight to the next non-empty shell.
+            k = min_deg;
+            continue;
+        }
+
+        while (!frontier.empty()) {
+            for (NodeId v : frontier) {
+                removed[v].store(true, std::memory_order_relaxed);
+                core[v] = k;
+            }
+            remaining -= frontier.size();
+
+            // A neighbour joins the shell exactly once: when its degree crosses
+            // from k + 1 to k. fetch_sub makes that transition unique.
+            std::vector<NodeId> next;
+            parallel::for_each_chunk(0, frontier.size(), [&](std::size_t lo, std::size_t hi, unsigned int) {
+                std::vector<NodeId> local;
+                for (std::size_t i = lo; i < hi; ++i) {
+                    for (NodeId u : graph.neighbors(frontier[i])) {
+                        if (removed[u].load(std::memory_order_relaxed)) continue;
+                        std::uint32_t old = deg[u].fetch_sub(1, std::memory_order_relaxed);
+                        if (old == k + 1) local.push_back(u);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(merge_mtx);
+                next.insert(next.end(), local.begin(), local.end());
+            }, threads);
+            frontier.swap(next);
+        }
+        ++k;
+    }
+    return core;
+}
+
+graph::PpiGraph k_core(const graph::PpiGraph& graph, std::uint32_t k) {
+    std::vector<std::uint32_t> core = core_numbers(graph);
+    std::vector<bool> keep(graph.num_nodes());
+    for (NodeId v = 0; v < graph.num_nodes(); ++v) {
+        keep[v] = core[v] >= k;
+    }
+    return graph::induced_subgraph(graph, keep);
+}
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,171 @@
+#include "tangle/algo/metrics.hpp"
+#include "tangle/parallel.hpp"
+#include <atomic>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tangle {
+namespace algo {
+
+namespace {
+
+// Merges two sorted, duplicate-free arrays and calls on_match(x) for every
+// common element x. The SSE2 path compares blocks of 4x4 elements at once:
+// `b` is rotated through all four lanes and compared against `a`, then the
+// block with the smaller maximum is advanced. The scalar merge finishes the tails.
+template <typename OnMatch>
+void intersect_sorted(const NodeId* a, std::size_t na,
+                      const NodeId* b, std::size_t nb, OnMatch&& on_match) {
+    std::size_t i = 0, j = 0;
+
+#if defined(__SSE2__)
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i m0 = _mm_cmpeq_epi32(va, vb);
+        __m128i m1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+        __m128i m2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m128i m3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+        __m128i m = _mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(m));
+        while (mask) {
+            int lane = __builtin_ctz(mask);
+            on_match(a[i + lane]);
+            mask &= mask - 1;
+        }
+
+        NodeId a_max = a[i + 3];
+        NodeId b_max = b[j + 3];
+        if (a_max <= b_max) i += 4;
+        if (b_max <= a_max) j += 4;
+    }
+#endif
+
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            on_match(a[i]);
+            ++i;
+            ++j;
+        }
+    }
+}
+
+// Degree-ordered orientation: keeps only neighbours of higher rank, where
+// rank orders by (degree, id). Rows stay sorted by NodeId.
+struct OrientedGraph {
+    std::vector<EdgeId> offsets;
+    std::vector<NodeId> targets;
+
+    OrientedGraph(const graph::CsrGraph& graph, unsigned int threads) {
+        const std::size_t n = graph.num_nodes();
+        auto higher = [&graph](NodeId u, NodeId v) {
+            std::size_t du = graph.degree(u), dv = graph.degree(v);
+            return dv > du || (dv == du && v > u);
+        };
+
+        offsets.assign(n + 1, 0);
+        parallel::parallel_for(0, n, [&](std::size_t u) {
+            EdgeId c = 0;
+            for (NodeId v : graph.neighbors(static_cast<NodeId>(u))) {
+                if (higher(static_cast<NodeId>(u), v)) ++c;
+            }
+            offsets[u + 1] = c;
+        }, 1024, threads);
+        for (std::size_t u = 0; u < n; ++u) offsets[u + 1] += offsets[u];
+
+        targets.resize(offsets[n]);
+        parallel::parallel_for(0, n, [&](std::size_t u) {
+            EdgeId out = offsets[u];
+            for (NodeId v : graph.neighbors(static_cast<NodeId>(u))) {
+                if (higher(static_cast<NodeId>(u), v)) targets[out++] = v;
+            }
+        }, 1024, threads);
+    }
+
+    const NodeId* row(NodeId u) const { return targets.data() + offsets[u]; }
+    std::size_t out_degree(NodeId u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+} // namespace
+
+std::uint64_t count_triangles(const graph::CsrGraph& graph, unsigned int threads) {
+    OrientedGraph dag(graph, threads);
+    std::atomic<std::uint64_t> total{0};
+
+    parallel::parallel_for(0, graph.num_nodes(), [&](std::size_t u) {
+        NodeId uu = static_cast<NodeId>(u);
+        const NodeId* nu = dag.row(uu);
+        std::size_t du = dag.out_degree(uu);
+        std::uint64_t local = 0;
+        for (std::size_t k = 0; k < du; ++k) {
+            NodeId v = nu[k];
+            intersect_sorted(nu, du, dag.row(v), dag.out_degree(v),
+                             [&local](NodeId) { ++local; });
+        }
+        if (local) total.fetch_add(local, std::memory_order_relaxed);
+    }, 64, threads);
+
+    return total.load();
+}
+
+std::uint64_t count_triangles(const graph::PpiGraph& graph, unsigned int threads) {
+    return count_triangles(graph::CsrGraph(graph), threads);
+}
+
+std::vector<std::uint64_t> node_triangles(const graph::CsrGraph& graph, unsigned int threads) {
+    const std::size_t n = graph.num_nodes();
+    OrientedGraph dag(graph, threads);
+    std::vector<std::atomic<std::uint64_t>> counts(n);
+    for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+
+    // For every oriented edge (u, v), each common out-neighbour w closes the
+    // triangle {u, v, w}; credit all three corners.
+    parallel::parallel_for(0, n, [&](std::size_t u) {
+        NodeId uu = static_cast<NodeId>(u);
+        const NodeId* nu = dag.row(uu);
+        std::size_t du = dag.out_degree(uu);
+        std::uint64_t local_u = 0;
+        for (std::size_t k = 0; k < du; ++k) {
+            NodeId v = nu[k];
+            std::uint64_t local_v = 0;
+            intersect_sorted(nu, du, dag.row(v), dag.out_degree(v), [&](NodeId w) {
+                counts[w].fetch_add(1, std::memory_order_relaxed);
+                ++local_v;
+            });
+            if (local_v) {
+                counts[v].fetch_add(local_v, std::memory_order_relaxed);
+                local_u += local_v;
+            }
+        }
+        if (local_u) counts[u].fetch_add(local_u, std::memory_order_relaxed);
+    }, 64, threads);
+
+    std::vector<std::uint64_t> result(n);
+    for (std::size_t v = 0; v < n; ++v) result[v] = counts[v].load(std::memory_order_relaxed);
+    return result;
+}
+
+std::vector<double> clustering_coefficient(const graph::CsrGraph& graph, unsigned int threads) {
+    std::vector<std::uint64_t> tri = node_triangles(graph, threads);
+    std::vector<double> cc(graph.num_nodes(), 0.0);
+    for (NodeId v = 0; v < graph.num_nodes(); ++v) {
+        double d = static_cast<double>(graph.degree(v));
+        if (d >= 2.0) {
+            cc[v] = static_cast<double>(tri[v]) / (d * (d - 1.0) / 2.0);
+        }
+    }
+    return cc;
+}
+
+std::vector<double> clustering_coefficient(const graph::PpiGraph& graph, unsigned int threads) {
+    return clustering_coefficient(graph::CsrGraph(graph), threads);
+}
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,177 @@
+#include "tangle/algo/null_model.hpp"
+#include "tangle/csr_graph.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+
+namespace tangle {
+namespace algo {
+
+namespace {
+
+constexpr std::uint64_t kEmpty = ~std::uint64_t(0);
+constexpr std::uint64_t kTombstone = ~std::uint64_t(0) - 1;
+
+std::uint64_t edge_key(NodeId u, NodeId v) {
+    if (u > v) std::swap(u, v);
+    return (static_cast<std::uint64_t>(u) << 32) | v;
+}
+
+std::uint64_t hash_key(std::uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    return k ^ (k >> 33);
+}
+
+// Lock-free set of undirected edges with linear probing. Slots go
+// empty -> key -> tombstone and are never reused, so the table is rebuilt
+// between rounds of swaps to drop the tombstones.
+class ConcurrentEdgeSet {
+public:
+    ConcurrentEdgeSet(const std::vector<graph::Edge>& edges, std::size_t max_inserts) {
+        std::size_t cap = 16;
+        while (cap < 2 * (edges.size() + max_inserts)) cap <<= 1;
+        mask_ = cap - 1;
+        slots_ = std::vector<std::atomic<std::uint64_t>>(cap);
+        for (auto& s : slots_) s.store(kEmpty, std::memory_order_relaxed);
+        for (const auto& e : edges) insert(edge_key(e.u, e.v));
+    }
+
+    // Returns true if this call inserted the key, false if it was present.
+    bool insert(std::uint64_t key) {
+        for (std::size_t i = hash_key(key) & mask_;; i = (i + 1) & mask_) {
+            std::uint64_t cur = slots_[i].load(std::memory_order_acquire);
+            if (cur == key) return false;
+            if (cur == kEmpty) {
+                if (slots_[i].compare_exchange_strong(cur, key, std::memory_order_acq_rel)) {
+                    return true;
+                }
+                if (cur == key) return false;
+            }
+        }
+    }
+
+    void erase(std::uint64_t key) {
+        for (std::size_t i = hash_key(key) & mask_;; i = (i + 1) & mask_) {
+            std::uint64_t cur = slots_[i].load(std::memory_order_acquire);
+            if (cur == kEmpty) return;
+            if (cur == key) {
+                slots_[i].compare_exchange_strong(cur, kTombstone, std::memory_order_acq_rel);
+                return;
+            }
+        }
+    }
+
+private:
+    std::vector<std::atomic<std::uint64_t>> slots_;
+    std::size_t mask_ = 0;
+};
+
+class SpinLocks {
+public:
+    explicit SpinLocks(std::size_t n) : flags_(n) {
+        for (auto& f : flags_) f.store(false, std::memory_order_relaxed);
+    }
+    bool try_lock(std::size_t i) { return !flags_[i].exchange(true, std::memory_order_acquire); }
+    void unlock(std::size_t i) { flags_[i].store(false, std::memory_order_release); }
+
+private:
+    std::vector<std::atomic<bool>> flags_;
+};
+
+// One entry per undirected pair of the deduplicated graph, with u < v.
+std::vector<graph::Edge> simple_edges(const graph::PpiGraph& graph) {
+    graph::CsrGraph csr(graph);
+    std::vector<graph::Edge> edges;
+    edges.reserve(csr.num_edges());
+    for (NodeId u = 0; u < csr.num_nodes(); ++u) {
+        auto nbrs = csr.neighbors(u);
+        auto w = csr.neighbor_weights(u);
+        for (std::size_t i = 0; i < nbrs.size(); ++i) {
+            if (u < nbrs[i]) edges.push_back(graph::Edge{u, nbrs[i], w[i]});
+        }
+    }
+    return edges;
+}
+
+std::vector<graph::Edge> swap_edges(std::vector<graph::Edge> edges, double swaps_per_edge,
+                                    std::uint64_t seed, unsigned int threads) {
+    const std::size_t m = edges.size();
+    if (m < 2 || swaps_per_edge <= 0.0) return edges;
+    if (threads == 0) threads = parallel::num_threads();
+
+    const std::uint64_t total_swaps =
+        static_cast<std::uint64_t>(std::ceil(swaps_per_edge * static_cast<double>(m)));
+    const std::uint64_t per_round = std::max<std::uint64_t>(m, 1);
+    SpinLocks locks(m);
+
+    std::uint64_t done = 0;
+    for (std::uint64_t round = 0; done < total_swaps; ++round) {
+        std::uint64_t round_swaps = std::min(per_round, total_swaps - done);
+        ConcurrentEdgeSet present(edges, 2 * round_swaps);
+
+        parallel::for_each_chunk(0, round_swaps, [&](std::size_t lo, std::size_t hi, unsigned int t) {
+            std::mt19937_64 rng(seed * 0x9e3779b97f4a7c15ULL + round * 0x100000001b3ULL + t);
+            std::uniform_int_distribution<std::size_t> pick(0, m - 1);
+            for (std::size_t s = lo; s < hi; ++s) {
+                std::size_t i = pick(rng), j = pick(rng);
+                if (i == j || !locks.try_lock(i)) continue;
+                if (!locks.try_lock(j)) {
+                    locks.unlock(i);
+                    continue;
+                }
+
+                NodeId a = edges[i].u, b = edges[i].v;
+                NodeId c = edges[j].u, d = edges[j].v;
+                if (rng() & 1) std::swap(c, d);
+                // Proposed: (a,d) and (c,b)
+                if (a != d && c != b) {
+                    std::uint64_t k1 = edge_key(a, d), k2 = edge_key(c, b);
+                    if (k1 != k2 && present.insert(k1)) {
+                        if (present.insert(k2)) {
+                            present.erase(edge_key(a, b));
+                            present.erase(edge_key(c, d));
+                            edges[i].u = a;
+                            edges[i].v = d;
+                            edges[j].u = c;
+                            edges[j].v = b;
+                        } else {
+                            present.erase(k1);
+                        }
+                    }
+                }
+                locks.unlock(j);
+                locks.unlock(i);
+            }
+        }, threads);
+        done += round_swaps;
+    }
+
+    for (auto& e : edges) {
+        if (e.u > e.v) std::swap(e.u, e.v);
+    }
+    return edges;
+}
+
+} // namespace
+
+std::vector<graph::Edge> randomize_edges(const graph::PpiGraph& graph, double swaps_per_edge,
+                                         std::uint64_t seed, unsigned int threads) {
+    return swap_edges(simple_edges(graph), swaps_per_edge, seed, threads);
+}
+
+void generate_null_models(const graph::PpiGraph& graph, std::size_t count,
+                          const std::function<void(std::size_t, const std::vector<graph::Edge>&)>& sink,
+                          double swaps_per_edge, std::uint64_t seed, unsigned int threads) {
+    std::vector<graph::Edge> base = simple_edges(graph);
+    for (std::size_t i = 0; i < count; ++i) {
+        sink(i, swap_edges(base, swaps_per_edge, seed + i, threads));
+    }
+}
+
+} // namespace algo
+} // namespace tangle
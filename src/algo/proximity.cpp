@@ -0,0 +1,146 @@
+#include "tangle/algo/proximity.hpp"
+#include "tangle/algo/traversal.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace tangle {
+namespace algo {
+
+namespace {
+
+// SplitMix64 finaliser: decorrelates the per-sample seeds.
+std::uint64_t mix_seed(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+NetworkProximity::NetworkProximity(const graph::PpiGraph& graph, std::size_t min_bin_size)
+    : graph_(graph), csr_(graph), bin_of_(graph.num_nodes(), 0) {
+    const std::size_t n = csr_.num_nodes();
+    if (min_bin_size == 0) min_bin_size = 1;
+
+    std::vector<NodeId> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](NodeId a, NodeId b) {
+        return csr_.degree(a) != csr_.degree(b) ? csr_.degree(a) < csr_.degree(b) : a < b;
+    });
+
+    // Walk nodes by increasing degree, never splitting a degree value across
+    // bins, and close a bin once it holds at least min_bin_size nodes.
+    std::size_t i = 0;
+    while (i < n) {
+        std::vector<NodeId> bin;
+        while (i < n && bin.size() < min_bin_size) {
+            std::size_t d = csr_.degree(order[i]);
+            while (i < n && csr_.degree(order[i]) == d) bin.push_back(order[i++]);
+        }
+        if (bin.size() < min_bin_size && !bin_members_.empty()) {
+            // Too few high-degree nodes left: fold them into the previous bin.
+            auto& last = bin_members_.back();
+            last.insert(last.end(), bin.begin(), bin.end());
+        } else {
+            bin_members_.push_back(std::move(bin));
+        }
+    }
+    for (std::uint32_t b = 0; b < bin_members_.size(); ++b) {
+        for (NodeId v : bin_members_[b]) bin_of_[v] = b;
+    }
+}
+
+std::vector<NodeId> NetworkProximity::resolve(const std::vector<ProteinId>& proteins) const {
+    std::vector<NodeId> nodes;
+    for (const auto& pid : proteins) {
+        if (auto id = graph_.find_node(pid)) nodes.push_back(*id);
+    }
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    return nodes;
+}
+
+double NetworkProximity::closest_distance(const std::vector<NodeId>& targets,
+                                          const std::vector<NodeId>& disease_nodes) const {
+    if (targets.empty() || disease_nodes.empty()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    // One multi-source BFS from the disease module gives min_s d(s, t) for every t.
+    std::vector<std::uint32_t> dist = bfs(csr_, disease_nodes, kNoParent, 1).distance;
+    double sum = 0.0;
+    std::size_t reached = 0;
+    for (NodeId t : targets) {
+        if (dist[t] != kUnreachable) {
+            sum += dist[t];
+            ++reached;
+        }
+    }
+    return reached ? sum / reached : std::numeric_limits<double>::infinity();
+}
+
+ProximityResult NetworkProximity::compute(const std::vector<ProteinId>& drug_targets,
+                                          const std::vector<ProteinId>& disease_genes,
+                                          std::size_t num_samples, std::uint64_t seed,
+                                          unsigned int threads) const {
+    ProximityResult result;
+    std::vector<NodeId> targets = resolve(drug_targets);
+    std::vector<NodeId> disease = resolve(disease_genes);
+    result.num_targets = targets.size();
+    result.num_disease_genes = disease.size();
+    result.distance = closest_distance(targets, disease);
+    if (!std::isfinite(result.distance)) return result;
+
+    // Draws a node from the same degree bin as each member, avoiding repeats
+    // within one set while the bin still has unused nodes.
+    auto sample_like = [this](const std::vector<NodeId>& nodes, std::mt19937_64& rng) {
+        std::vector<NodeId> out;
+        out.reserve(nodes.size());
+        for (NodeId v : nodes) {
+            const auto& bin = bin_members_[bin_of_[v]];
+            std::uniform_int_distribution<std::size_t> pick(0, bin.size() - 1);
+            NodeId r = bin[pick(rng)];
+            for (int tries = 0; tries < 32 && std::find(out.begin(), out.end(), r) != out.end(); ++tries) {
+                r = bin[pick(rng)];
+            }
+            out.push_back(r);
+        }
+        return out;
+    };
+
+    std::vector<double> random_d(num_samples);
+    parallel::parallel_for(0, num_samples, [&](std::size_t i) {
+        std::mt19937_64 rng(mix_seed(seed ^ mix_seed(i)));
+        std::vector<NodeId> rt = sample_like(targets, rng);
+        std::vector<NodeId> rs = sample_like(disease, rng);
+        random_d[i] = closest_distance(rt, rs);
+    }, 8, threads);
+
+    double sum = 0.0, sum_sq = 0.0;
+    std::size_t count = 0;
+    for (double d : random_d) {
+        if (!std::isfinite(d)) continue;
+        sum += d;
+        sum_sq += d * d;
+        ++count;
+    }
+    result.num_samples = count;
+    if (count == 0) return result;
+
+    result.random_mean = sum / count;
+    if (count > 1) {
+        double var = (sum_sq - count * result.random_mean * result.random_mean) / (count - 1);
+        result.random_sd = std::sqrt(std::max(0.0, var));
+    }
+    if (result.random_sd > 0.0) {
+        result.z_score = (result.distance - result.random_mean) / result.random_sd;
+    }
+    return result;
+}
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,148 @@
+#include "tangle/algo/quality.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace tangle {
+namespace algo {
+
+namespace {
+
+// Sparse contingency table of two labelings plus their marginals.
+struct Contingency {
+    std::unordered_map<std::uint64_t, double> joint;
+    std::unordered_map<NodeId, double> rows;
+    std::unordered_map<NodeId, double> cols;
+    double n = 0.0;
+};
+
+Contingency contingency(const std::vector<NodeId>& a, const std::vector<NodeId>& b) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("Partitions must cover the same nodes");
+    }
+    Contingency t;
+    t.n = static_cast<double>(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        t.joint[(static_cast<std::uint64_t>(a[i]) << 32) | b[i]] += 1.0;
+        t.rows[a[i]] += 1.0;
+        t.cols[b[i]] += 1.0;
+    }
+    return t;
+}
+
+double pairs(double x) { return x * (x - 1.0) / 2.0; }
+
+} // namespace
+
+PartitionQuality evaluate_partition(const graph::CsrGraph& graph,
+                                    const std::vector<NodeId>& membership,
+                                    bool use_weights, double resolution,
+                                    unsigned int threads) {
+    const std::size_t n = graph.num_nodes();
+    if (membership.size() != n) {
+        throw std::invalid_argument("Membership size does not match node count");
+    }
+    std::size_t num_comms = 0;
+    for (NodeId c : membership) num_comms = std::max<std::size_t>(num_comms, c + 1);
+    if (threads == 0) threads = parallel::num_threads();
+
+    // Per-thread accumulators of internal weight (seen from both endpoints)
+    // and volume, merged after the pass.
+    std::vector<std::vector<double>> inner(threads), volume(threads);
+    parallel::for_each_chunk(0, n, [&](std::size_t lo, std::size_t hi, unsigned int t) {
+        std::vector<double>& in = inner[t];
+        std::vector<double>& vol = volume[t];
+        in.assign(num_comms, 0.0);
+        vol.assign(num_comms, 0.0);
+        for (std::size_t u = lo; u < hi; ++u) {
+            NodeId cu = membership[u];
+            auto nbrs = graph.neighbors(static_cast<NodeId>(u));
+            auto wts = graph.neighbor_weights(static_cast<NodeId>(u));
+            for (std::size_t i = 0; i < nbrs.size(); ++i) {
+                double w = use_weights ? wts[i] : 1.0;
+                vol[cu] += w;
+                if (membership[nbrs[i]] == cu) in[cu] += w;
+            }
+        }
+    }, threads);
+
+    PartitionQuality q;
+    q.communities.resize(num_comms);
+    for (NodeId c : membership) q.communities[c].size++;
+    for (unsigned int t = 0; t < threads; ++t) {
+        if (inner[t].empty()) continue;
+        for (std::size_t c = 0; c < num_comms; ++c) {
+            q.communities[c].internal_weight += inner[t][c] / 2.0;
+            q.communities[c].volume += volume[t][c];
+        }
+    }
+
+    double two_m = 0.0;
+    for (const auto& c : q.communities) two_m += c.volume;
+    double m = two_m / 2.0;
+
+    double internal_total = 0.0;
+    for (auto& c : q.communities) {
+        double size = static_cast<double>(c.size);
+        c.cut_weight = c.volume - 2.0 * c.internal_weight;
+        c.density = c.size >= 2 ? c.internal_weight / pairs(size) : 0.0;
+        double denom = std::min(c.volume, two_m - c.volume);
+        c.conductance = denom > 0.0 ? c.cut_weight / denom : 0.0;
+
+        internal_total += c.internal_weight;
+        q.cpm += c.internal_weight - resolution * pairs(size);
+        if (m > 0.0) {
+            double frac = c.volume / two_m;
+            q.modularity += c.internal_weight / m - resolution * frac * frac;
+        }
+    }
+    q.coverage = m > 0.0 ? internal_total / m : 0.0;
+    return q;
+}
+
+double normalized_mutual_information(const std::vector<NodeId>& a, const std::vector<NodeId>& b) {
+    Contingency t = contingency(a, b);
+    if (t.n == 0.0) return 1.0;
+
+    auto entropy = [&t](const std::unordered_map<NodeId, double>& marginal) {
+        double h = 0.0;
+        for (const auto& kv : marginal) {
+            double p = kv.second / t.n;
+            h -= p * std::log(p);
+        }
+        return h;
+    };
+    double ha = entropy(t.rows);
+    double hb = entropy(t.cols);
+    if (ha + hb == 0.0) return 1.0;
+
+    double mi = 0.0;
+    for (const auto& kv : t.joint) {
+        NodeId ra = static_cast<NodeId>(kv.first >> 32);
+        NodeId cb = static_cast<NodeId>(kv.first & 0xffffffffu);
+        double nij = kv.second;
+        mi += nij / t.n * std::log(nij * t.n / (t.rows[ra] * t.cols[cb]));
+    }
+    return 2.0 * mi / (ha + hb);
+}
+
+double adjusted_rand_index(const std::vector<NodeId>& a, const std::vector<NodeId>& b) {
+    Contingency t = contingency(a, b);
+    if (t.n < 2.0) return 1.0;
+
+    double sum_ij = 0.0, sum_a = 0.0, sum_b = 0.0;
+    for (const auto& kv : t.joint) sum_ij += pairs(kv.second);
+    for (const auto& kv : t.rows) sum_a += pairs(kv.second);
+    for (const auto& kv : t.cols) sum_b += pairs(kv.second);
+
+    double expected = sum_a * sum_b / pairs(t.n);
+    double max_index = (sum_a + sum_b) / 2.0;
+    if (max_index == expected) return 1.0;
+    return (sum_ij - expected) / (max_index - expected);
+}
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,173 @@
+#include "tangle/algo/reorder.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace tangle {
+namespace algo {
+
+namespace {
+
+// Turns a visiting sequence (old ids in new order) into v -> new_id[v].
+std::vector<NodeId> invert(const std::vector<NodeId>& sequence) {
+    std::vector<NodeId> new_id(sequence.size());
+    for (std::size_t i = 0; i < sequence.size(); ++i) {
+        new_id[sequence[i]] = static_cast<NodeId>(i);
+    }
+    return new_id;
+}
+
+std::vector<NodeId> by_ascending_degree(const graph::CsrGraph& graph) {
+    std::vector<NodeId> nodes(graph.num_nodes());
+    std::iota(nodes.begin(), nodes.end(), 0);
+    std::stable_sort(nodes.begin(), nodes.end(), [&](NodeId a, NodeId b) {
+        return graph.degree(a) < graph.degree(b);
+    });
+    return nodes;
+}
+
+} // namespace
+
+NodeOrder parse_node_order(const std::string& name) {
+    if (name == "degree") return NodeOrder::Degree;
+    if (name == "rcm") return NodeOrder::Rcm;
+    if (name == "rabbit") return NodeOrder::Rabbit;
+    throw std::invalid_argument("Unknown node order '" + name + "' (expected degree, rcm or rabbit)");
+}
+
+std::vector<NodeId> degree_order(const graph::CsrGraph& graph) {
+    std::vector<NodeId> nodes(graph.num_nodes());
+    std::iota(nodes.begin(), nodes.end(), 0);
+    std::stable_sort(nodes.begin(), nodes.end(), [&](NodeId a, NodeId b) {
+        return graph.degree(a) > graph.degree(b);
+    });
+    return invert(nodes);
+}
+
+std::vector<NodeId> rcm_order(const graph::CsrGraph& graph) {
+    const std::size_t n = graph.num_nodes();
+    std::vector<char> visited(n, 0);
+    std::vector<NodeId> sequence;
+    sequence.reserve(n);
+    std::vector<NodeId> next;
+
+    for (NodeId start : by_ascending_degree(graph)) {
+        if (visited[start]) continue;
+        visited[start] = 1;
+        std::size_t head = sequence.size();
+        sequence.push_back(start);
+        for (; head < sequence.size(); ++head) {
+            next.clear();
+            for (NodeId u : graph.neighbors(sequence[head])) {
+                if (!visited[u]) {
+                    visited[u] = 1;
+                    next.push_back(u);
+                }
+            }
+            std::sort(next.begin(), next.end(), [&](NodeId a, NodeId b) {
+                return graph.degree(a) != graph.degree(b) ? graph.degree(a) < graph.degree(b)
+                                                          : a < b;
+            });
+            sequence.insert(sequence.end(), next.begin(), next.end());
+        }
+    }
+    std::reverse(sequence.begin(), sequence.end());
+    return invert(sequence);
+}
+
+std::vector<NodeId> rabbit_order(const graph::CsrGraph& graph) {
+    const std::size_t n = graph.num_nodes();
+    const double two_m = static_cast<double>(graph.targets().size());
+
+    std::vector<NodeId> dest(n);
+    std::iota(dest.begin(), dest.end(), 0);
+    auto find = [&](NodeId x) {
+        while (dest[x] != x) {
+            dest[x] = dest[dest[x]];
+            x = dest[x];
+        }
+        return x;
+    };
+
+    std::vector<double> strength(n);
+    for (NodeId v = 0; v < n; ++v) strength[v] = static_cast<double>(graph.degree(v));
+
+    // Edges inherited from merged members, not yet folded into the CSR row.
+    std::vector<std::vector<std::pair<NodeId, double>>> inherited(n);
+    std::vector<std::vector<NodeId>> children(n);
+    std::vector<NodeId> top_level;
+
+    std::vector<double> weight_to(n, 0.0);
+    std::vector<NodeId> touched;
+    for (NodeId u : by_ascending_degree(graph)) {
+        // u is still a root: only the node being visited is ever merged.
+        touched.clear();
+        auto accumulate = [&](NodeId x, double w) {
+            NodeId c = find(x);
+            if (c == u) return;
+            if (weight_to[c] == 0.0) touched.push_back(c);
+            weight_to[c] += w;
+        };
+        for (NodeId x : graph.neighbors(u)) accumulate(x, 1.0);
+        for (const auto& [x, w] : inherited[u]) accumulate(x, w);
+
+        NodeId best = u;
+        double best_gain = 0.0;
+        for (NodeId c : touched) {
+            double gain = weight_to[c] - strength[u] * strength[c] / two_m;
+            if (gain > best_gain) {
+                best_gain = gain;
+                best = c;
+            }
+        }
+
+        if (best == u) {
+            top_level.push_back(u);
+        } else {
+            dest[u] = best;
+            strength[best] += strength[u];
+            children[best].push_back(u);
+            auto& target = inherited[best];
+            for (NodeId c : touched) {
+                if (c != best) target.emplace_back(c, weight_to[c]);
+            }
+        }
+        for (NodeId c : touched) weight_to[c] = 0.0;
+        std::vector<std::pair<NodeId, double>>().swap(inherited[u]);
+    }
+
+    // Depth-first walk: every dendrogram subtree gets a contiguous id range.
+    std::vector<NodeId> sequence;
+    sequence.reserve(n);
+    std::vector<NodeId> stack;
+    for (NodeId root : top_level) {
+        stack.push_back(root);
+        while (!stack.empty()) {
+            NodeId v = stack.back();
+            stack.pop_back();
+            sequence.push_back(v);
+            stack.insert(stack.end(), children[v].rbegin(), children[v].rend());
+        }
+    }
+    return invert(sequence);
+}
+
+std::vector<NodeId> node_order(const graph::CsrGraph& graph, NodeOrder order) {
+    switch (order) {
+        case NodeOrder::Degree: return degree_order(graph);
+        case NodeOrder::Rcm: return rcm_order(graph);
+        case NodeOrder::Rabbit: return rabbit_order(graph);
+    }
+    throw std::invalid_argument("Unknown node order");
+}
+
+ReorderedGraph::ReorderedGraph(const graph::CsrGraph& graph, NodeOrder order)
+    : new_id_(node_order(graph, order)) {
+    original_id_.resize(new_id_.size());
+    for (NodeId v = 0; v < new_id_.size(); ++v) original_id_[new_id_[v]] = v;
+    graph_ = graph.permute(new_id_);
+}
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,100 @@
+#include "tangle/algo/streaming.hpp"
+#include "tangle/algo/centrality.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace tangle {
+namespace algo {
+
+std::vector<NodeId> label_propagation(const io::EdgeStream& edges, std::size_t max_passes,
+                                      bool use_weights) {
+    const std::size_t n = edges.num_nodes();
+    std::vector<NodeId> labels(n);
+    for (NodeId v = 0; v < n; ++v) labels[v] = v;
+
+    std::vector<NodeId> candidate(n);
+    std::vector<double> count(n);
+    auto vote = [&](NodeId v, NodeId label, double w) {
+        if (candidate[v] == label) {
+            count[v] += w;
+        } else if (count[v] >= w) {
+            count[v] -= w;
+        } else {
+            candidate[v] = label;
+            count[v] = w - count[v];
+        }
+    };
+
+    for (std::size_t pass = 0; pass < max_passes; ++pass) {
+        candidate = labels;
+        std::fill(count.begin(), count.end(), 1.0);
+        edges.for_each_edge([&](const graph::Edge& e) {
+            if (e.u >= n || e.v >= n) {
+                throw std::out_of_range("NodeId out of range in edge file");
+            }
+            if (e.u == e.v) return;
+            double w = use_weights ? e.weight : 1.0;
+            vote(e.u, labels[e.v], w);
+            vote(e.v, labels[e.u], w);
+        });
+
+        std::size_t changed = 0;
+        for (NodeId v = 0; v < n; ++v) {
+            if (count[v] > 0.0 && candidate[v] != labels[v]) {
+                labels[v] = candidate[v];
+                ++changed;
+            }
+        }
+        if (changed == 0) break;
+    }
+
+    // Dense ids in order of each community's smallest node.
+    constexpr NodeId kUnassigned = static_cast<NodeId>(-1);
+    std::vector<NodeId> dense(n, kUnassigned);
+    NodeId next = 0;
+    for (NodeId v = 0; v < n; ++v) {
+        NodeId& d = dense[labels[v]];
+        if (d == kUnassigned) d = next++;
+        labels[v] = d;
+    }
+    return labels;
+}
+
+std::vector<double> pagerank(const io::EdgeStream& edges, double damping,
+                             std::size_t max_iterations, double tolerance, bool use_weights) {
+    const std::size_t n = edges.num_nodes();
+    if (n == 0) return {};
+    if (damping < 0.0 || damping > 1.0) {
+        throw std::invalid_argument("PageRank damping must be in [0, 1]");
+    }
+
+    std::vector<double> strength = degree_centrality(edges, use_weights);
+    std::vector<double> rank(n, 1.0 / static_cast<double>(n));
+    std::vector<double> next(n);
+
+    for (std::size_t iter = 0; iter < max_iterations; ++iter) {
+        std::fill(next.begin(), next.end(), 0.0);
+        edges.for_each_edge([&](const graph::Edge& e) {
+            double w = use_weights ? e.weight : 1.0;
+            next[e.v] += rank[e.u] * w / strength[e.u];
+            next[e.u] += rank[e.v] * w / strength[e.v];
+        });
+
+        double dangling = 0.0;
+        for (std::size_t v = 0; v < n; ++v) {
+            if (strength[v] == 0.0) dangling += rank[v];
+        }
+        const double base = (1.0 - damping + damping * dangling) / static_cast<double>(n);
+        double delta = 0.0;
+        for (std::size_t v = 0; v < n; ++v) {
+            next[v] = base + damping * next[v];
+            delta += std::abs(next[v] - rank[v]);
+        }
+        rank.swap(next);
+        if (delta < tolerance) break;
+    }
+    return rank;
+}
+
+} // namespace algo
+} // namespace tangle
@@ -0,0 +1,245 @@
+#include "tangle/algo/traversal.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+namespace tangle {
+namespace algo {
+
+namespace {
+
+// Beamer et al.'s switching thresholds.
+constexpr std::uint64_t kAlpha = 15; // top-down -> bottom-up when m_f > m_u / alpha
+constexpr std::uint64_t kBeta = 18;  // bottom-up -> top-down when n_f < n / beta
+
+// Levels with less work than this run on the calling thread only.
+constexpr std::size_t kParallelCutoff = 4096;
+
+class Bitmap {
+public:
+    explicit Bitmap(std::size_t n) : words_((n + 63) / 64, 0) {}
+    void clear() { std::fill(words_.begin(), words_.end(), 0); }
+    bool test(std::size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1u; }
+    void set(std::size_t i) { words_[i >> 6] |= std::uint64_t(1) << (i & 63); }
+    std::size_t num_words() const { return words_.size(); }
+    void swap(Bitmap& other) { words_.swap(other.words_); }
+
+private:
+    std::vector<std::uint64_t> words_;
+};
+
+unsigned int level_threads(std::size_t work, unsigned int threads) {
+    return work < kParallelCutoff ? 1u : threads;
+}
+
+// Shared by the CsrGraph and CompressedCsrGraph overloads; only needs
+// num_nodes(), num_edges(), degree() and iterable neighbors().
+template <typename Graph>
+BfsResult bfs_impl(const Graph& graph, const std::vector<NodeId>& sources,
+                   NodeId target, unsigned int threads) {
+    const std::size_t n = graph.num_nodes();
+    if (threads == 0) threads = parallel::num_threads();
+
+    std::vector<std::atomic<NodeId>> parent(n);
+    std::vector<std::uint32_t> distance(n, kUnreachable);
+    for (auto& p : parent) p.store(kNoParent, std::memory_order_relaxed);
+
+    // Visited nodes have parent != kNoParent; sources point to themselves
+    // during the search and are reset to kNoParent at the end.
+    std::vector<NodeId> frontier;
+    for (NodeId s : sources) {
+        if (s >= n) throw std::out_of_range("NodeId out of range in bfs");
+        if (parent[s].load(std::memory_order_relaxed) != kNoParent) continue;
+        parent[s].store(s, std::memory_order_relaxed);
+        distance[s] = 0;
+        frontier.push_back(s);
+    }
+
+    std::uint64_t edges_unexplored = 2 * static_cast<std::uint64_t>(graph.num_edges());
+    std::uint64_t edges_frontier = 0;
+    for (NodeId v : frontier) edges_frontier += graph.degree(v);
+
+    Bitmap front_bits(n), next_bits(n);
+    bool bottom_up = false;
+    std::uint32_t level = 0;
+    std::mutex merge_mtx;
+
+    auto target_found = [&]() {
+        return target != kNoParent && target < n &&
+               parent[target].load(std::memory_order_relaxed) != kNoParent;
+    };
+
+    while (!frontier.empty() && !target_found()) {
+        if (!bottom_up && edges_frontier > edges_unexplored / kAlpha) {
+            bottom_up = true;
+            front_bits.clear();
+            for (NodeId v : frontier) front_bits.set(v);
+        }
+
+        std::vector<NodeId> next;
+        std::uint64_t next_edges = 0;
+
+        if (bottom_up) {
+            // Every unvisited node scans its neighbours for a frontier member.
+            // Threads own whole bitmap words, so the next bitmap needs no atomics.
+            next_bits.clear();
+            parallel::for_each_chunk(0, front_bits.num_words(),
+                [&](std::size_t wlo, std::size_t whi, unsigned int) {
+                    std::vector<NodeId> local;
+                    std::uint64_t local_edges = 0;
+                    std::size_t vlo = wlo * 64, vhi = std::min(n, whi * 64);
+                    for (std::size_t v = vlo; v < vhi; ++v) {
+                        if (parent[v].load(std::memory_order_relaxed) != kNoParent) continue;
+                        for (NodeId u : graph.neighbors(static_cast<NodeId>(v))) {
+                            if (front_bits.test(u)) {
+                                parent[v].store(u, std::memory_order_relaxed);
+                                distance[v] = level + 1;
+                                next_bits.set(v);
+                                local.push_back(static_cast<NodeId>(v));
+                                local_edges += graph.degree(static_cast<NodeId>(v));
+                                break;
+                            }
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(merge_mtx);
+                    next.insert(next.end(), local.begin(), local.end());
+                    next_edges += local_edges;
+                }, level_threads(n, threads));
+            front_bits.swap(next_bits);
+
+            if (next.size() < n / kBeta) bottom_up = false;
+        } else {
+            // Frontier nodes claim unvisited neighbours with a CAS on parent.
+            parallel::for_each_chunk(0, frontier.size(),
+                [&](std::size_t lo, std::size_t hi, unsigned int) {
+                    std::vector<NodeId> local;
+                    std::uint64_t local_edges = 0;
+                    for (std::size_t i = lo; i < hi; ++i) {
+                        NodeId u = frontier[i];
+                        for (NodeId v : graph.neighbors(u)) {
+                            if (parent[v].load(std::memory_order_relaxed) != kNoParent) continue;
+                            NodeId expected = kNoParent;
+                            if (parent[v].compare_exchange_strong(expected, u,
+                                                                  std::memory_order_relaxed)) {
+                                distance[v] = level + 1;
+                                local.push_back(v);
+                                local_edges += graph.degree(v);
+                            }
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(merge_mtx);
+                    next.insert(next.end(), local.begin(), local.end());
+                    next_edges += local_edges;
+                }, level_threads(edges_frontier, threads));
+        }
+
+        edges_unexplored = edges_unexplored > edges_frontier ? edges_unexplored - edges_frontier : 0;
+        edges_frontier = next_edges;
+        frontier.swap(next);
+        ++level;
+    }
+
+    BfsResult result;
+    result.distance = std::move(distance);
+    result.parent.resize(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        NodeId p = parent[v].load(std::memory_order_relaxed);
+        result.parent[v] = (p == v) ? kNoParent : p;
+    }
+    return result;
+}
+
+} // namespace
+
+BfsResult bfs(const graph::CsrGraph& graph, const std::vector<NodeId>& sources,
+              NodeId target, unsigned int threads) {
+    return bfs_impl(graph, sources, target, threads);
+}
+
+BfsResult bfs(const graph::CompressedCsrGraph& graph, const std::vector<NodeId>& sources,
+              NodeId target, unsigned int threads) {
+    return bfs_impl(graph, sources, target, threads);
+}
+
+std::vector<std::uint32_t> distances_from(const graph::CsrGraph& graph, NodeId source,
+                                          unsigned int threads) {
+    return bfs(graph, {source}, kNoParent, threads).distance;
+}
+
+std::vector<std::uint32_t> distances_from(const graph::CompressedCsrGraph& graph, NodeId source,
+                                          unsigned int threads) {
+    return bfs(graph, {source}, kNoParent, threads).distance;
+}
+
+std::vector<std::uint32_t> distances_from(const graph::GraphOverlay& graph, NodeId source) {
+    if (source >= graph.num_nodes()) {
+        throw std::out_of_range("NodeId out of range in distances_from");
+    }
+    std::vector<std::uint32_t> distance(graph.num_nodes(), kUnreachable);
+    if (graph.is_removed(source)) return distance;
+    distance[source] = 0;
+    std::vector<NodeId> queue{source};
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        NodeId v = queue[head];
+        graph.for_each_neighbor(v, [&](NodeId u, Weight) {
+            if (distance[u] == kUnreachable) {
+                distance[u] = distance[v] + 1;
+                queue.push_back(u);
+            }
+        });
+    }
+    return distance;
+}
+
+std::vector<NodeId> shortest_path(const graph::CsrGraph& graph, NodeId u, NodeId v,
+                                  unsigned int threads) {
+    if (v >= graph.num_nodes()) {
+        throw std::out_of_range("NodeId out of range in shortest_path");
+    }
+    BfsResult r = bfs(graph, {u}, v, threads);
+    if (r.distance[v] == kUnreachable) return {};
+
+    std::vector<NodeId> path;
+    for (NodeId x = v; x != kNoParent; x = r.parent[x]) {
+        path.push_back(x);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<NodeId> k_hop_neighborhood(const graph::CsrGraph& graph, NodeId center,
+                                       std::uint32_t k) {
+    if (center >= graph.num_nodes()) {
+        throw std::out_of_range("NodeId out of range in k_hop_neighborhood");
+    }
+    // Ego networks are small, so a plain level-bounded BFS is cheapest here.
+    std::vector<std::uint32_t> distance(graph.num_nodes(), kUnreachable);
+    std::vector<NodeId> visited = {center};
+    distance[center] = 0;
+    for (std::size_t head = 0; head < visited.size(); ++head) {
+        NodeId u = visited[head];
+        if (distance[u] == k) continue;
+        for (NodeId v : graph.neighbors(u)) {
+            if (distance[v] == kUnreachable) {
+                distance[v] = distance[u] + 1;
+                visited.push_back(v);
+            }
+        }
+    }
+    std::sort(visited.begin(), visited.end());
+    return visited;
+}
+
+graph::PpiGraph ego_network(const graph::PpiGraph& graph, NodeId center, std::uint32_t k) {
+    graph::CsrGraph csr(graph);
+    std::vector<bool> keep(graph.num_nodes(), false);
+    for (NodeId v : k_hop_neighborhood(csr, center, k)) {
+        keep[v] = true;
+    }
+    return graph::induced_subgraph(graph, keep);
+}
+
+} // namespace algo
+} // namespace tangle
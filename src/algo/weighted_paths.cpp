@@ -0,0 +1,244 @@
+#include "tangle/algo/weighted_paths.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace tangle {
+namespace algo {
+
+namespace {
+
+// Non-negative doubles order the same way as their bit patterns.
+std::uint64_t to_key(double d) {
+    std::uint64_t k;
+    std::memcpy(&k, &d, sizeof(k));
+    return k;
+}
+
+// Monotone radix heap: valid because Dijkstra never pushes a key smaller than
+// the last one popped. Bucket i holds keys whose highest bit differing from
+// `last_` is bit i-1; bucket 0 holds keys equal to `last_`.
+class RadixHeap {
+public:
+    bool empty() const { return size_ == 0; }
+
+    void push(double dist, NodeId v) {
+        std::uint64_t key = to_key(dist);
+        buckets_[bucket_of(key)].push_back({key, v});
+        ++size_;
+    }
+
+    // Smallest key currently in the heap; requires !empty().
+    double top_distance() {
+        refill();
+        double d;
+        std::memcpy(&d, &last_, sizeof(d));
+        return d;
+    }
+
+    std::pair<double, NodeId> pop() {
+        refill();
+        auto entry = buckets_[0].back();
+        buckets_[0].pop_back();
+        --size_;
+        double d;
+        std::memcpy(&d, &entry.first, sizeof(d));
+        return {d, entry.second};
+    }
+
+private:
+    std::array<std::vector<std::pair<std::uint64_t, NodeId>>, 65> buckets_;
+    std::uint64_t last_ = 0;
+    std::size_t size_ = 0;
+
+    std::size_t bucket_of(std::uint64_t key) const {
+        return key == last_ ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(key ^ last_));
+    }
+
+    void refill() {
+        if (!buckets_[0].empty()) return;
+        std::size_t i = 1;
+        while (buckets_[i].empty()) ++i;
+        std::uint64_t new_last = buckets_[i][0].first;
+        for (const auto& e : buckets_[i]) new_last = std::min(new_last, e.first);
+        last_ = new_last;
+        for (const auto& e : buckets_[i]) buckets_[bucket_of(e.first)].push_back(e);
+        buckets_[i].clear();
+    }
+};
+
+void check_lengths(const graph::CsrGraph& graph, const std::vector<double>& lengths) {
+    if (lengths.size() != graph.targets().size()) {
+        throw std::invalid_argument("Edge lengths must be aligned with CsrGraph::targets()");
+    }
+}
+
+void check_node(const graph::CsrGraph& graph, NodeId v) {
+    if (v >= graph.num_nodes()) {
+        throw std::out_of_range("NodeId out of range in weighted shortest path");
+    }
+}
+
+// Runs Dijkstra from `source`, optionally stopping once `pending` targets
+// (marked in `is_target`) have all been settled.
+std::vector<double> run_dijkstra(const graph::CsrGraph& graph, const std::vector<double>& lengths,
+                                 NodeId source, const std::vector<char>* is_target,
+                                 std::size_t pending) {
+    const auto& offsets = graph.offsets();
+    const auto& targets = graph.targets();
+    std::vector<double> dist(graph.num_nodes(), kInfiniteDistance);
+    RadixHeap heap;
+    dist[source] = 0.0;
+    heap.push(0.0, source);
+
+    while (!heap.empty()) {
+        auto [d, u] = heap.pop();
+        if (d > dist[u]) continue; // stale entry
+        if (is_target && (*is_target)[u]) {
+            if (--pending == 0) break;
+        }
+        for (EdgeId e = offsets[u]; e < offsets[u + 1]; ++e) {
+            double nd = d + lengths[e];
+            NodeId v = targets[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push(nd, v);
+            }
+        }
+    }
+    return dist;
+}
+
+} // namespace
+
+std::vector<double> confidence_lengths(const graph::CsrGraph& graph, double max_score) {
+    if (max_score <= 0.0) {
+        throw std::invalid_argument("max_score must be positive");
+    }
+    const auto& weights = graph.weights();
+    std::vector<double> lengths(weights.size());
+    const double min_score = max_score * 1e-12;
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        double s = std::min(max_score, std::max(min_score, weights[i]));
+        // std::max also turns -0.0 (score == max_score) into +0.0 for the radix heap.
+        lengths[i] = std::max(0.0, -std::log(s / max_score));
+    }
+    return lengths;
+}
+
+std::vector<double> dijkstra(const graph::CsrGraph& graph, const std::vector<double>& lengths,
+                             NodeId source) {
+    check_lengths(graph, lengths);
+    check_node(graph, source);
+    return run_dijkstra(graph, lengths, source, nullptr, 0);
+}
+
+WeightedPath shortest_weighted_path(const graph::CsrGraph& graph, const std::vector<double>& lengths,
+                                    NodeId u, NodeId v) {
+    check_lengths(graph, lengths);
+    check_node(graph, u);
+    check_node(graph, v);
+
+    WeightedPath result;
+    if (u == v) {
+        result.nodes = {u};
+        result.length = 0.0;
+        return result;
+    }
+
+    const std::size_t n = graph.num_nodes();
+    const auto& offsets = graph.offsets();
+    const auto& targets = graph.targets();
+
+    // Index 0 is the forward search from u, index 1 the backward search from v.
+    std::array<std::vector<double>, 2> dist = {std::vector<double>(n, kInfiniteDistance),
+                                               std::vector<double>(n, kInfiniteDistance)};
+    std::array<std::vector<NodeId>, 2> pred = {std::vector<NodeId>(n, u),
+                                               std::vector<NodeId>(n, v)};
+    std::array<std::vector<char>, 2> settled = {std::vector<char>(n, 0), std::vector<char>(n, 0)};
+    std::array<RadixHeap, 2> heap;
+    dist[0][u] = 0.0;
+    dist[1][v] = 0.0;
+    heap[0].push(0.0, u);
+    heap[1].push(0.0, v);
+
+    double best = kInfiniteDistance;
+    NodeId meet_a = v, meet_b = v; // best path is u ~> meet_a -- meet_b ~> v
+
+    while (!heap[0].empty() && !heap[1].empty()) {
+        double top0 = heap[0].top_distance();
+        double top1 = heap[1].top_distance();
+        if (top0 + top1 >= best) break;
+
+        int side = top0 <= top1 ? 0 : 1;
+        auto [d, x] = heap[side].pop();
+        if (d > dist[side][x] || settled[side][x]) continue;
+        settled[side][x] = 1;
+
+        for (EdgeId e = offsets[x]; e < offsets[x + 1]; ++e) {
+            NodeId y = targets[e];
+            double nd = d + lengths[e];
+            if (nd < dist[side][y]) {
+                dist[side][y] = nd;
+                pred[side][y] = x;
+                heap[side].push(nd, y);
+            }
+            double through = nd + dist[1 - side][y];
+            if (through < best) {
+                best = through;
+                meet_a = side == 0 ? x : y;
+                meet_b = side == 0 ? y : x;
+            }
+        }
+    }
+
+    if (best == kInfiniteDistance) return result;
+
+    result.length = best;
+    for (NodeId x = meet_a; x != u; x = pred[0][x]) result.nodes.push_back(x);
+    result.nodes.push_back(u);
+    std::reverse(result.nodes.begin(), result.nodes.end());
+    for (NodeId x = meet_b; ; x = pred[1][x]) {
+        result.nodes.push_back(x);
+        if (x == v) break;
+    }
+    return result;
+}
+
+std::vector<std::vector<double>> distance_matrix(const graph::CsrGraph& graph,
+                                                 const std::vector<double>& lengths,
+                                                 const std::vector<NodeId>& sources,
+                                                 const std::vector<NodeId>& targets,
+                                                 unsigned int threads) {
+    check_lengths(graph, lengths);
+    for (NodeId s : sources) check_node(graph, s);
+
+    std::vector<char> is_target(graph.num_nodes(), 0);
+    std::size_t distinct_targets = 0;
+    for (NodeId t : targets) {
+        check_node(graph, t);
+        if (!is_target[t]) {
+            is_target[t] = 1;
+            ++distinct_targets;
+        }
+    }
+
+    std::vector<std::vector<double>> result(sources.size());
+    parallel::parallel_for(0, sources.size(), [&](std::size_t i) {
+        std::vector<double> dist =
+            run_dijkstra(graph, lengths, sources[i], &is_target, distinct_targets);
+        result[i].resize(targets.size());
+        for (std::size_t j = 0; j < targets.size(); ++j) {
+            result[i][j] = dist[targets[j]];
+        }
+    }, 1, threads);
+    return result;
+}
+
+} // namespace algo
+} // namespace tangle
@@ -1,135 +1,616 @@
 #include "tangle/annotate/annotation_db.hpp"
+#include "tangle/io/input_file.hpp"
+#include "tangle/io/line_blocks.hpp"
+#include "tangle/io/mapped_file.hpp"
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <fstream>
-#include <sstream>
+#include <numeric>
 #include <stdexcept>
+#include <string_view>
+#include <unordered_map>
 
 namespace tangle {
 namespace annotate {
 
-void AnnotationDb::load_from_gaf(const std::string &filepath) {
-  std::ifstream infile(filepath);
-  if (!infile.is_open()) {
-    throw std::runtime_error("Could not open GAF file: " + filepath);
+namespace {
+
+struct GafRow {
+  std::string_view protein;
+  std::string_view symbol;
+  std::string_view go_id;
+};
+
+bool contains(const std::vector<std::string> &list, std::string_view value) {
+  for (const auto &item : list) {
+    if (item == value) {
+      return true;
+    }
   }
+  return false;
+}
 
-  protein_to_go_.clear();
-  all_go_terms_.clear();
+// True if `token` is one of the '|'-separated entries of `field`.
+bool has_entry(std::string_view field, std::string_view token) {
+  size_t pos = 0;
+  while (true) {
+    size_t bar = field.find('|', pos);
+    if (field.substr(pos, bar - pos) == token) {
+      return true;
+    }
+    if (bar == std::string_view::npos) {
+      return false;
+    }
+    pos = bar + 1;
+  }
+}
+
+std::string_view strip_taxon_prefix(std::string_view taxon) {
+  constexpr std::string_view prefix = "taxon:";
+  if (taxon.substr(0, prefix.size()) == prefix) {
+    taxon.remove_prefix(prefix.size());
+  }
+  return taxon;
+}
+
+// Assigns dense indices to strings in first-seen order, storing each
+// distinct string once.
+class Interner {
+public:
+  uint32_t intern(std::string_view s) {
+    auto it = index_.find(s);
+    if (it != index_.end()) {
+      return it->second;
+    }
+    strings_.emplace_back(s); // deque elements never move
+    uint32_t id = static_cast<uint32_t>(strings_.size() - 1);
+    index_.emplace(strings_.back(), id);
+    return id;
+  }
 
-  // Temporary storage for all GO terms to allow bulk sorting/uniquing later if
-  // needed, but for all_go_terms_ we'll just insert and sort at the end.
+  const std::string &operator[](uint32_t i) const { return strings_[i]; }
+  size_t size() const { return strings_.size(); }
+
+private:
+  std::deque<std::string> strings_;
+  std::unordered_map<std::string_view, uint32_t> index_;
+};
+
+// Snapshot / in-memory image layout. All integers use the byte order of the
+// writing machine; every section starts on an 8-byte boundary.
+//
+//   Header
+//   protein_names  uint64[num_proteins + 1]  pool offsets, names sorted
+//   term_names     uint64[num_terms + 1]     pool offsets, names sorted
+//   protein_start  uint64[num_proteins + 1]  CSR row starts
+//   protein_terms  uint32[num_pairs]         term indices, sorted per row
+//   term_start     uint64[num_terms + 1]     inverted list starts
+//   term_proteins  uint32[num_pairs]         protein indices, sorted per list
+//   term_counts    uint32[num_terms]         proteins per term
+//   pool           char[pool_bytes]          protein names, then term names
+//
+// num_proteins is the enrichment background N.
+constexpr char kMagic[8] = {'T', 'N', 'G', 'L', 'A', 'N', 'N', '1'};
+constexpr uint32_t kByteOrder = 0x01020304;
+
+struct Header {
+  char magic[8];
+  uint32_t byte_order;
+  uint32_t reserved;
+  uint64_t num_proteins;
+  uint64_t num_terms;
+  uint64_t num_pairs;
+  uint64_t pool_bytes;
+  uint64_t protein_names;
+  uint64_t term_names;
+  uint64_t protein_start;
+  uint64_t protein_terms;
+  uint64_t term_start;
+  uint64_t term_proteins;
+  uint64_t term_counts;
+  uint64_t pool;
+  uint64_t total_bytes;
+};
+
+// Appends 8-byte aligned sections to an image after its header.
+class ImageBuilder {
+public:
+  ImageBuilder() : bytes_(sizeof(Header), 0) {}
+
+  template <typename T> uint64_t append(const std::vector<T> &values) {
+    return append(values.data(), values.size() * sizeof(T));
+  }
+
+  uint64_t append(const void *data, size_t size) {
+    bytes_.resize((bytes_.size() + 7) & ~size_t{7}, 0);
+    const uint64_t offset = bytes_.size();
+    const char *begin = static_cast<const char *>(data);
+    bytes_.insert(bytes_.end(), begin, begin + size);
+    return offset;
+  }
+
+  std::vector<char> finish(Header header) {
+    header.total_bytes = bytes_.size();
+    std::memcpy(bytes_.data(), &header, sizeof(header));
+    return std::move(bytes_);
+  }
+
+private:
+  std::vector<char> bytes_;
+};
+
+// Builds an image from sorted names and the two index directions.
+std::vector<char> build_image(const std::vector<std::string_view> &proteins,
+                              const std::vector<std::string_view> &terms,
+                              const std::vector<uint64_t> &protein_start,
+                              const std::vector<uint32_t> &protein_terms,
+                              const std::vector<uint64_t> &term_start,
+                              const std::vector<uint32_t> &term_proteins,
+                              const std::vector<uint32_t> &term_counts) {
+  std::string pool;
+  std::vector<uint64_t> protein_names;
+  std::vector<uint64_t> term_names;
+  protein_names.reserve(proteins.size() + 1);
+  term_names.reserve(terms.size() + 1);
+  for (auto name : proteins) {
+    protein_names.push_back(pool.size());
+    pool += name;
+  }
+  protein_names.push_back(pool.size());
+  for (auto name : terms) {
+    term_names.push_back(pool.size());
+    pool += name;
+  }
+  term_names.push_back(pool.size());
 
-  std::string line;
-  // Reserve reasonable space to avoid reallocations if possible
-  // Estimating lines is hard without seeking, so rely on vector growth.
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.byte_order = kByteOrder;
+  header.num_proteins = proteins.size();
+  header.num_terms = terms.size();
+  header.num_pairs = protein_terms.size();
+  header.pool_bytes = pool.size();
 
-  while (std::getline(infile, line)) {
+  ImageBuilder image;
+  header.protein_names = image.append(protein_names);
+  header.term_names = image.append(term_names);
+  header.protein_start = image.append(protein_start);
+  header.protein_terms = image.append(protein_terms);
+  header.term_start = image.append(term_start);
+  header.term_proteins = image.append(term_proteins);
+  header.term_counts = image.append(term_counts);
+  header.pool = image.append(pool.data(), pool.size());
+  return image.finish(header);
+}
+
+} // namespace
+
+// An image, either built in memory or mapped from a snapshot.
+struct AnnotationDb::Storage {
+  std::vector<char> image;
+  std::unique_ptr<io::MappedFile> file;
+
+  std::string_view bytes() const {
+    return file ? file->text() : std::string_view(image.data(), image.size());
+  }
+};
+
+void AnnotationDb::load_from_gaf(const std::string &filepath) {
+  load_from_gaf(filepath, GafFilter{});
+}
+
+void AnnotationDb::load_from_gaf(const std::string &filepath,
+                                 const GafFilter &filter) {
+  // Columns used (0-based): 1 DB Object ID -> ProteinId, 2 Symbol,
+  // 3 Qualifier, 4 GO ID, 6 Evidence, 8 Aspect, 12 Taxon. Only as many as
+  // the filter needs are split; rows that are too short are dropped.
+  size_t needed = 5;
+  if (!filter.evidence_codes.empty() || !filter.excluded_evidence.empty()) {
+    needed = 7;
+  }
+  if (!filter.aspects.empty()) {
+    needed = 9;
+  }
+  if (!filter.taxon.empty()) {
+    needed = 13;
+  }
+  const std::string_view taxon = strip_taxon_prefix(filter.taxon);
+
+  // Runs on the parser threads.
+  auto parse = [&](std::string_view line, std::vector<GafRow> &rows) {
     if (line.empty() || line[0] == '!') { // Skip empty lines and comments
-      continue;
+      return;
     }
-
-    // Optimized parsing using find/substr to avoid stringstream overhead
+    std::string_view cols[13];
+    size_t n = 0;
     size_t pos = 0;
-    int col_idx = 0;
-    std::string protein_id;
-    std::string protein_symbol;
-    std::string go_id;
-    bool found_prot = false;
-    bool found_symbol = false;
-    bool found_go = false;
-
-    // We need column 2 (index 1) for ProteinId, column 3 (index 2) for Symbol,
-    // and column 5 (index 4) for GO ID.
-    // Columns are tab-separated.
-
-    size_t next_pos;
-    while ((next_pos = line.find('\t', pos)) != std::string::npos) {
-      if (col_idx == 1) {
-        protein_id = line.substr(pos, next_pos - pos);
-        found_prot = true;
-      } else if (col_idx == 2) {
-        protein_symbol = line.substr(pos, next_pos - pos);
-        found_symbol = true;
-      } else if (col_idx == 4) {
-        go_id = line.substr(pos, next_pos - pos);
-        found_go = true;
-        break; // We have what we need
+    while (n < needed) {
+      size_t tab = line.find('\t', pos);
+      cols[n++] = line.substr(pos, tab - pos);
+      if (tab == std::string_view::npos) {
+        break;
       }
-      pos = next_pos + 1;
-      col_idx++;
+      pos = tab + 1;
+    }
+    if (n < needed || cols[1].empty() || cols[4].empty()) {
+      return;
+    }
+    if (filter.skip_negated && has_entry(cols[3], "NOT")) {
+      return;
+    }
+    if (!filter.evidence_codes.empty() &&
+        !contains(filter.evidence_codes, cols[6])) {
+      return;
+    }
+    if (contains(filter.excluded_evidence, cols[6])) {
+      return;
+    }
+    if (!filter.aspects.empty() &&
+        (cols[8].size() != 1 ||
+         filter.aspects.find(cols[8][0]) == std::string::npos)) {
+      return;
+    }
+    if (!taxon.empty() &&
+        strip_taxon_prefix(cols[12].substr(0, cols[12].find('|'))) != taxon) {
+      return;
+    }
+    rows.push_back({cols[1], cols[2], cols[4]});
+  };
+
+  // Proteins and symbols share one key space, as both index protein_to_go_.
+  // Symbols are not always unique, but for enrichment it's better to be
+  // permissive.
+  Interner keys;
+  Interner terms;
+  std::vector<std::pair<uint32_t, uint32_t>> pairs; // (key, term)
+  uint32_t last_protein = 0;
+  uint32_t last_symbol = 0;
+  auto consume = [&](const GafRow &row) {
+    // GAF rows come grouped by protein, so most rows reuse the last key.
+    if (keys.size() == 0 || keys[last_protein] != row.protein) {
+      last_protein = keys.intern(row.protein);
+    }
+    uint32_t term = terms.intern(row.go_id);
+    pairs.emplace_back(last_protein, term);
+    if (!row.symbol.empty()) {
+      if (keys[last_symbol] != row.symbol) {
+        last_symbol = keys.intern(row.symbol);
+      }
+      pairs.emplace_back(last_symbol, term);
+    }
+  };
+
+  if (io::detect_compression(filepath) == io::Compression::None) {
+    io::MappedFile file(filepath);
+    if (!file.is_open()) {
+      throw std::runtime_error("Could not open GAF file: " + filepath);
+    }
+    io::parse_line_blocks<GafRow>(file.text(), parse, consume, filter.threads);
+  } else {
+    io::InputFile infile(filepath);
+    if (!infile.is_open()) {
+      throw std::runtime_error("Could not open GAF file: " + filepath);
+    }
+    io::parse_line_blocks<GafRow>(infile, parse, consume, filter.threads);
+  }
+
+  // Number proteins and terms in sorted order, so both index directions
+  // come out sorted by name.
+  auto sorted_order = [](const Interner &names) {
+    std::vector<uint32_t> order(names.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+    return order;
+  };
+  const std::vector<uint32_t> key_order = sorted_order(keys);
+  const std::vector<uint32_t> term_order = sorted_order(terms);
+  std::vector<uint32_t> key_rank(keys.size());
+  std::vector<uint32_t> term_rank(terms.size());
+  for (uint32_t r = 0; r < key_order.size(); ++r) {
+    key_rank[key_order[r]] = r;
+  }
+  for (uint32_t r = 0; r < term_order.size(); ++r) {
+    term_rank[term_order[r]] = r;
+  }
+
+  // Bucket the pairs by protein, then sort and unique each protein's terms.
+  std::vector<uint64_t> protein_start(keys.size() + 1, 0);
+  for (const auto &pair : pairs) {
+    protein_start[key_rank[pair.first] + 1]++;
+  }
+  std::partial_sum(protein_start.begin(), protein_start.end(),
+                   protein_start.begin());
+  std::vector<uint32_t> protein_terms(pairs.size());
+  {
+    std::vector<uint64_t> cursor(protein_start.begin(), protein_start.end() - 1);
+    for (const auto &pair : pairs) {
+      protein_terms[cursor[key_rank[pair.first]]++] = term_rank[pair.second];
     }
+  }
+  pairs.clear();
+  pairs.shrink_to_fit();
 
-    // Handle case where GO ID might be the last column
-    if (!found_go && col_idx == 4) {
-      go_id = line.substr(pos);
-      found_go = true;
+  std::vector<uint32_t> term_counts(terms.size(), 0);
+  uint64_t kept = 0;
+  for (size_t p = 0; p < keys.size(); ++p) {
+    auto first = protein_terms.begin() + protein_start[p];
+    auto last = protein_terms.begin() + protein_start[p + 1];
+    std::sort(first, last);
+    last = std::unique(first, last);
+    protein_start[p] = kept;
+    for (auto it = first; it != last; ++it) {
+      protein_terms[kept++] = *it;
+      term_counts[*it]++; // frequencies count each protein once
     }
+  }
+  protein_start[keys.size()] = kept;
+  protein_terms.resize(kept);
+  protein_terms.shrink_to_fit();
 
-    if (found_prot && found_go && !go_id.empty()) {
-      // We don't check for uniqueness here to avoid O(N) search on every
-      // insert. We will sort and unique later.
-      protein_to_go_[protein_id].push_back(go_id);
-      all_go_terms_.push_back(go_id);
+  // Inverted lists, filled in protein order so each list is sorted.
+  std::vector<uint64_t> term_start(terms.size() + 1, 0);
+  for (size_t t = 0; t < terms.size(); ++t) {
+    term_start[t + 1] = term_start[t] + term_counts[t];
+  }
+  std::vector<uint32_t> term_proteins(kept);
+  {
+    std::vector<uint64_t> cursor(term_start.begin(), term_start.end() - 1);
+    for (uint32_t p = 0; p < keys.size(); ++p) {
+      for (uint64_t i = protein_start[p]; i < protein_start[p + 1]; ++i) {
+        term_proteins[cursor[protein_terms[i]]++] = p;
+      }
+    }
+  }
+
+  std::vector<std::string_view> protein_names;
+  std::vector<std::string_view> term_names;
+  protein_names.reserve(keys.size());
+  term_names.reserve(terms.size());
+  for (uint32_t k : key_order) {
+    protein_names.push_back(keys[k]);
+  }
+  for (uint32_t t : term_order) {
+    term_names.push_back(terms[t]);
+  }
 
-      // Dual Indexing: Note that Symbols are not always unique, but for
-      // enrichment it's better to be permissive.
-      if (found_symbol && !protein_symbol.empty()) {
-        protein_to_go_[protein_symbol].push_back(go_id);
+  auto storage = std::make_shared<Storage>();
+  storage->image = build_image(protein_names, term_names, protein_start,
+                               protein_terms, term_start, term_proteins,
+                               term_counts);
+  attach(std::move(storage), filepath);
+}
+
+void AnnotationDb::save_binary(const std::string &filepath) const {
+  std::vector<char> empty;
+  std::string_view bytes;
+  if (storage_) {
+    bytes = storage_->bytes();
+  } else {
+    empty = build_image({}, {}, {0}, {}, {0}, {}, {});
+    bytes = std::string_view(empty.data(), empty.size());
+  }
+
+  std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error(
+        "Could not open file for writing annotation snapshot: " + filepath);
+  }
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  out.close();
+  if (!out) {
+    throw std::runtime_error("Failed to write annotation snapshot: " +
+                             filepath);
+  }
+}
+
+void AnnotationDb::open_binary(const std::string &filepath) {
+  auto storage = std::make_shared<Storage>();
+  storage->file = std::make_unique<io::MappedFile>(filepath);
+  if (!storage->file->is_open()) {
+    throw std::runtime_error("Could not open annotation snapshot: " +
+                             filepath);
+  }
+  attach(std::move(storage), filepath);
+}
+
+bool AnnotationDb::is_binary_snapshot(const std::string &filepath) {
+  std::ifstream in(filepath, std::ios::binary);
+  char magic[sizeof(kMagic)] = {};
+  return in.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+void AnnotationDb::attach(std::shared_ptr<const Storage> storage,
+                          const std::string &origin) {
+  const std::string_view bytes = storage->bytes();
+  auto invalid = [&](const std::string &why) {
+    return std::runtime_error("Invalid annotation snapshot " + origin + ": " +
+                              why);
+  };
+  Header header{};
+  if (bytes.size() < sizeof(header)) {
+    throw invalid("file too short");
+  }
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw invalid("bad magic");
+  }
+  if (header.byte_order != kByteOrder) {
+    throw invalid("written with a different byte order");
+  }
+  if (header.total_bytes != bytes.size()) {
+    throw invalid("truncated");
+  }
+
+  // Every section must lie inside the image and be 8-byte aligned.
+  auto section = [&](uint64_t offset, uint64_t count, size_t width) {
+    if (offset % 8 != 0 || offset < sizeof(Header) || offset > bytes.size() ||
+        count > (bytes.size() - offset) / width) {
+      throw invalid("section out of bounds");
+    }
+    return bytes.data() + offset;
+  };
+  const uint64_t np = header.num_proteins;
+  const uint64_t nt = header.num_terms;
+  const uint64_t pairs = header.num_pairs;
+  auto u64 = [](const char *p) { return reinterpret_cast<const uint64_t *>(p); };
+  auto u32 = [](const char *p) { return reinterpret_cast<const uint32_t *>(p); };
+  // Checked before any narrowing, so huge counts cannot wrap.
+  const auto *protein_names = u64(section(header.protein_names, np + 1, 8));
+  const auto *term_names = u64(section(header.term_names, nt + 1, 8));
+  const auto *protein_start = u64(section(header.protein_start, np + 1, 8));
+  const auto *protein_terms = u32(section(header.protein_terms, pairs, 4));
+  const auto *term_start = u64(section(header.term_start, nt + 1, 8));
+  const auto *term_proteins = u32(section(header.term_proteins, pairs, 4));
+  const auto *term_counts = u32(section(header.term_counts, nt, 4));
+  const char *pool = section(header.pool, header.pool_bytes, 1);
+  // One linear pass over the index arrays, so that no lookup on a corrupt
+  // file can read outside the image.
+  auto monotonic = [](const uint64_t *offsets, uint64_t count, uint64_t last) {
+    for (uint64_t i = 0; i < count; ++i) {
+      if (offsets[i] > offsets[i + 1]) {
+        return false;
+      }
+    }
+    return offsets[count] <= last;
+  };
+  auto in_range = [](const uint32_t *indices, uint64_t count, uint64_t limit) {
+    for (uint64_t i = 0; i < count; ++i) {
+      if (indices[i] >= limit) {
+        return false;
       }
     }
+    return true;
+  };
+  if (!monotonic(protein_names, np, header.pool_bytes) ||
+      !monotonic(term_names, nt, header.pool_bytes) ||
+      protein_start[0] != 0 || !monotonic(protein_start, np, pairs) ||
+      protein_start[np] != pairs || term_start[0] != 0 ||
+      !monotonic(term_start, nt, pairs) || term_start[nt] != pairs) {
+    throw invalid("inconsistent index");
   }
+  for (uint64_t t = 0; t < nt; ++t) {
+    if (term_counts[t] != term_start[t + 1] - term_start[t]) {
+      throw invalid("inconsistent term counts");
+    }
+  }
+  if (!in_range(protein_terms, pairs, nt) ||
+      !in_range(term_proteins, pairs, np)) {
+    throw invalid("index out of range");
+  }
+
+  storage_ = std::move(storage);
+  num_proteins_ = np;
+  num_terms_ = nt;
+  pool_ = pool;
+  protein_names_ = protein_names;
+  term_names_ = term_names;
+  protein_start_ = protein_start;
+  protein_terms_ = protein_terms;
+  term_start_ = term_start;
+  term_proteins_ = term_proteins;
+  term_counts_ = term_counts;
+}
+
+std::string_view AnnotationDb::protein_name(size_t p) const {
+  return std::string_view(pool_ + protein_names_[p],
+                          protein_names_[p + 1] - protein_names_[p]);
+}
 
-  // Post-process: Sort and Unique
-  term_counts_.clear();
-  for (auto &pair : protein_to_go_) {
-    std::sort(pair.second.begin(), pair.second.end());
-    pair.second.erase(std::unique(pair.second.begin(), pair.second.end()),
-                      pair.second.end());
+std::string_view AnnotationDb::term_name(size_t t) const {
+  return std::string_view(pool_ + term_names_[t],
+                          term_names_[t + 1] - term_names_[t]);
+}
+
+namespace {
 
-    // Count frequencies after uniquing for this protein
-    for (const auto &term : pair.second) {
-      term_counts_[term]++;
+// Binary search over `count` sorted names.
+template <typename NameFn>
+size_t find_sorted(size_t count, std::string_view key, NameFn name) {
+  size_t lo = 0;
+  size_t hi = count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (name(mid) < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
+  return lo < count && name(lo) == key ? lo : std::string_view::npos;
+}
+
+} // namespace
 
-  std::sort(all_go_terms_.begin(), all_go_terms_.end());
-  all_go_terms_.erase(std::unique(all_go_terms_.begin(), all_go_terms_.end()),
-                      all_go_terms_.end());
+size_t AnnotationDb::find_protein(std::string_view protein) const {
+  return find_sorted(num_proteins_, protein,
+                     [this](size_t p) { return protein_name(p); });
 }
 
-const std::vector<GoTermId> &
+size_t AnnotationDb::find_term(std::string_view go_term) const {
+  return find_sorted(num_terms_, go_term,
+                     [this](size_t t) { return term_name(t); });
+}
+
+std::vector<GoTermId>
 AnnotationDb::get_annotations(const ProteinId &protein) const {
-  static const std::vector<GoTermId> empty_vec;
-  auto it = protein_to_go_.find(protein);
-  if (it != protein_to_go_.end()) {
-    return it->second;
+  std::vector<GoTermId> go_terms;
+  const size_t p = find_protein(protein);
+  if (p == std::string_view::npos) {
+    return go_terms;
+  }
+  go_terms.reserve(protein_start_[p + 1] - protein_start_[p]);
+  for (uint64_t i = protein_start_[p]; i < protein_start_[p + 1]; ++i) {
+    go_terms.emplace_back(term_name(protein_terms_[i]));
   }
-  return empty_vec;
+  return go_terms;
 }
 
 int AnnotationDb::get_term_frequency(const GoTermId &go_term) const {
-  auto it = term_counts_.find(go_term);
-  if (it != term_counts_.end()) {
-    return it->second;
+  const size_t t = find_term(go_term);
+  if (t == std::string_view::npos) {
+    return 0;
   }
-  return 0;
+  return static_cast<int>(term_counts_[t]);
 }
 
 std::vector<GoTermId> AnnotationDb::get_all_go_terms() const {
-  return all_go_terms_;
+  std::vector<GoTermId> go_terms;
+  go_terms.reserve(num_terms_);
+  for (size_t t = 0; t < num_terms_; ++t) {
+    go_terms.emplace_back(term_name(t));
+  }
+  return go_terms;
 }
 
 std::vector<ProteinId> AnnotationDb::get_all_annotated_proteins() const {
   std::vector<ProteinId> proteins;
-  proteins.reserve(protein_to_go_.size());
-  for (const auto &pair : protein_to_go_) {
-    proteins.push_back(pair.first);
+  proteins.reserve(num_proteins_);
+  for (size_t p = 0; p < num_proteins_; ++p) {
+    proteins.emplace_back(protein_name(p));
+  }
+  return proteins;
+}
+
+std::vector<ProteinId>
+AnnotationDb::get_annotated_proteins(const GoTermId &go_term) const {
+  std::vector<ProteinId> proteins;
+  const size_t t = find_term(go_term);
+  if (t == std::string_view::npos) {
+    return proteins;
+  }
+  proteins.reserve(term_start_[t + 1] - term_start_[t]);
+  for (uint64_t i = term_start_[t]; i < term_start_[t + 1]; ++i) {
+    proteins.emplace_back(protein_name(term_proteins_[i]));
   }
   return proteins;
 }
 
 bool AnnotationDb::has_annotations(const ProteinId &protein) const {
-  return protein_to_go_.count(protein) > 0;
+  return find_protein(protein) != std::string_view::npos;
 }
 
 } // namespace annotate
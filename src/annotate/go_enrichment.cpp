@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <map>
 #include <stdexcept>
+#include <string_view>
 
 namespace tangle {
 namespace annotate {
@@ -46,7 +47,7 @@ go_enrichment(const std::vector<ProteinId> &protein_set, const AnnotationDb &db,
   std::vector<GoEnrichmentResult> results;
 
   // N: total number of proteins in the background
-  const unsigned int N = db.get_all_annotated_proteins().size();
+  const unsigned int N = db.num_annotated_proteins();
   if (N == 0)
     return results;
 
@@ -56,28 +57,36 @@ go_enrichment(const std::vector<ProteinId> &protein_set, const AnnotationDb &db,
     return results;
 
   // 1. Identify unique GO terms in the query set and count 'k' (count in set)
-  std::map<GoTermId, int> unique_terms_in_set;
+  // and 'K' (count in background), both read from the annotation index.
+  // Keyed by term index, which follows the sorted term names.
+  struct TermCount {
+    std::string_view go_term;
+    int k = 0;
+    int K = 0;
+  };
+  std::map<std::size_t, TermCount> unique_terms_in_set;
   for (const auto &prot : protein_set) {
-    const auto &terms = db.get_annotations(prot);
-    for (const auto &term : terms) {
-      unique_terms_in_set[term]++;
-    }
+    db.for_each_annotation(prot, [&](std::size_t term, std::string_view go_term,
+                                     std::size_t frequency) {
+      TermCount &count = unique_terms_in_set[term];
+      count.go_term = go_term;
+      count.K = static_cast<int>(frequency);
+      count.k++;
+    });
   }
 
   // 2. Iterate ONLY over the terms present in the query set
   for (const auto &pair : unique_terms_in_set) {
-    const GoTermId &go_term = pair.first;
-    int k = pair.second; // count in set (already computed)
-
-    // Get K (count in background) - O(1) lookup
-    int K = db.get_term_frequency(go_term);
+    const TermCount &count = pair.second;
+    int k = count.k; // count in set (already computed)
+    int K = count.K; // count in background (already computed)
 
     // Perform HGT
     if (k > 0) { // Should always be true here
       double p_value =
           static_cast<double>(hypergeometric_cdf_upper(k, n, K, N));
 
-      GoEnrichmentResult res = {go_term,
+      GoEnrichmentResult res = {GoTermId(count.go_term),
                                 p_value,
                                 0.0, // adjusted p-value
                                 static_cast<unsigned int>(k),
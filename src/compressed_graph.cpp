@@ -0,0 +1,283 @@
+#include "tangle/compressed_graph.hpp"
+#include "tangle/io/edge_file.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+namespace tangle {
+namespace graph {
+
+namespace {
+
+std::size_t varint_size(std::uint64_t x) {
+    std::size_t n = 1;
+    while (x >= 0x80) {
+        x >>= 7;
+        ++n;
+    }
+    return n;
+}
+
+void write_varint(std::uint8_t*& p, std::uint64_t x) {
+    while (x >= 0x80) {
+        *p++ = static_cast<std::uint8_t>(x | 0x80);
+        x >>= 7;
+    }
+    *p++ = static_cast<std::uint8_t>(x);
+}
+
+std::uint64_t zigzag(NodeId v, NodeId first) {
+    std::int64_t delta = static_cast<std::int64_t>(first) - static_cast<std::int64_t>(v);
+    return (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+}
+
+std::size_t num_blocks(std::size_t degree) {
+    return degree == 0 ? 0 : (degree - 1) / CompressedCsrGraph::kBlockSize;
+}
+
+struct BlockEntry {
+    std::uint32_t byte_offset; // offset of the entry's gap within the row stream
+    NodeId value;
+};
+
+BlockEntry read_block(const std::uint8_t* blocks, std::size_t b) {
+    std::uint32_t entry[2];
+    std::memcpy(entry, blocks + b * sizeof(entry), sizeof(entry));
+    return {entry[0], entry[1]};
+}
+
+} // namespace
+
+std::size_t CompressedCsrGraph::row_bytes(NodeId v, NeighborRange nbrs) {
+    std::size_t bytes = varint_size(nbrs.size()) + num_blocks(nbrs.size()) * kBlockEntryBytes;
+    if (!nbrs.empty()) bytes += varint_size(zigzag(v, nbrs[0]));
+    for (std::size_t i = 1; i < nbrs.size(); ++i) {
+        bytes += varint_size(nbrs[i] - nbrs[i - 1] - 1);
+    }
+    return bytes;
+}
+
+void CompressedCsrGraph::write_row(std::uint8_t* p, NodeId v, NeighborRange nbrs) {
+    write_varint(p, nbrs.size());
+    if (nbrs.empty()) return;
+    std::uint8_t* block = p;
+    std::uint8_t* const stream = p + num_blocks(nbrs.size()) * kBlockEntryBytes;
+    p = stream;
+    write_varint(p, zigzag(v, nbrs[0]));
+    for (std::size_t i = 1; i < nbrs.size(); ++i) {
+        if (i % kBlockSize == 0) {
+            std::uint32_t entry[2] = {static_cast<std::uint32_t>(p - stream), nbrs[i]};
+            std::memcpy(block, entry, kBlockEntryBytes);
+            block += kBlockEntryBytes;
+        }
+        write_varint(p, nbrs[i] - nbrs[i - 1] - 1);
+    }
+}
+
+template <typename RowFn>
+void CompressedCsrGraph::encode(std::size_t n, RowFn&& row) {
+    offsets_.assign(n + 1, 0);
+
+    // 1. Size every row in parallel.
+    std::vector<EdgeId> degrees(n, 0);
+    parallel::parallel_for(0, n, [&](std::size_t v) {
+        NeighborRange nbrs = row(static_cast<NodeId>(v));
+        degrees[v] = nbrs.size();
+        offsets_[v + 1] = row_bytes(static_cast<NodeId>(v), nbrs);
+    });
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    num_entries_ = std::accumulate(degrees.begin(), degrees.end(), std::size_t{0});
+
+    // 2. Encode every row into its slot.
+    bytes_.resize(offsets_.back());
+    parallel::parallel_for(0, n, [&](std::size_t v) {
+        write_row(bytes_.data() + offsets_[v], static_cast<NodeId>(v), row(static_cast<NodeId>(v)));
+    });
+}
+
+CompressedCsrGraph::CompressedCsrGraph(const CsrGraph& graph) {
+    encode(graph.num_nodes(), [&](NodeId v) { return graph.neighbors(v); });
+}
+
+CompressedCsrGraph::CompressedCsrGraph(std::size_t num_nodes, const std::vector<Edge>& edges) {
+    // Unweighted counterpart of the CsrGraph build: count, scatter, then
+    // sort and deduplicate each row.
+    std::vector<EdgeId> counts(num_nodes + 1, 0);
+    for (const auto& e : edges) {
+        if (e.u >= num_nodes || e.v >= num_nodes) {
+            throw std::out_of_range("NodeId out of range in CompressedCsrGraph");
+        }
+        if (e.u == e.v) continue;
+        counts[e.u + 1]++;
+        counts[e.v + 1]++;
+    }
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+    std::vector<EdgeId> cursor(counts.begin(), counts.end() - 1);
+    std::vector<NodeId> raw(counts.back());
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        raw[cursor[e.u]++] = e.v;
+        raw[cursor[e.v]++] = e.u;
+    }
+    std::vector<EdgeId>().swap(cursor);
+
+    std::vector<NodeId> unique_len(num_nodes, 0);
+    parallel::parallel_for(0, num_nodes, [&](std::size_t v) {
+        auto first = raw.begin() + counts[v];
+        auto last = raw.begin() + counts[v + 1];
+        std::sort(first, last);
+        unique_len[v] = static_cast<NodeId>(std::unique(first, last) - first);
+    });
+
+    encode(num_nodes, [&](NodeId v) {
+        const NodeId* first = raw.data() + counts[v];
+        return NeighborRange{first, first + unique_len[v]};
+    });
+}
+
+CompressedCsrGraph::CompressedCsrGraph(const io::EdgeStream& edges, std::size_t buffer_entries) {
+    const std::size_t n = edges.num_nodes();
+    if (buffer_entries == 0) buffer_entries = 1;
+
+    // Pass 1: raw degrees (duplicates included), as prefix sums.
+    std::vector<EdgeId> counts(n + 1, 0);
+    edges.for_each_edge([&](const Edge& e) {
+        if (e.u >= n || e.v >= n) {
+            throw std::out_of_range("NodeId out of range in CompressedCsrGraph");
+        }
+        if (e.u == e.v) return;
+        counts[e.u + 1]++;
+        counts[e.v + 1]++;
+    });
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+    // Consecutive node ranges whose raw rows fit the buffer.
+    std::vector<std::size_t> bounds = {0};
+    for (std::size_t v = 0; v < n; ++v) {
+        if (v > bounds.back() && counts[v + 1] - counts[bounds.back()] > buffer_entries) {
+            bounds.push_back(v);
+        }
+    }
+    bounds.push_back(n);
+
+    // Reads the rows of nodes [lo, hi) into `raw`, then sorts and
+    // deduplicates each; unique_len[v - lo] is the row's final length.
+    std::vector<NodeId> raw;
+    std::vector<EdgeId> cursor;
+    std::vector<NodeId> unique_len;
+    auto fill = [&](std::size_t lo, std::size_t hi) {
+        const EdgeId base = counts[lo];
+        raw.resize(counts[hi] - base);
+        cursor.assign(counts.begin() + lo, counts.begin() + hi);
+        edges.for_each_batch([&](const Edge* batch, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const Edge& e = batch[i];
+                if (e.u == e.v) continue;
+                if (e.u >= lo && e.u < hi) raw[cursor[e.u - lo]++ - base] = e.v;
+                if (e.v >= lo && e.v < hi) raw[cursor[e.v - lo]++ - base] = e.u;
+            }
+        });
+        unique_len.assign(hi - lo, 0);
+        parallel::parallel_for(lo, hi, [&](std::size_t v) {
+            auto first = raw.begin() + (counts[v] - base);
+            auto last = raw.begin() + (counts[v + 1] - base);
+            std::sort(first, last);
+            unique_len[v - lo] = static_cast<NodeId>(std::unique(first, last) - first);
+        });
+    };
+    auto row = [&](std::size_t lo, std::size_t v) {
+        const NodeId* first = raw.data() + (counts[v] - counts[lo]);
+        return NeighborRange{first, first + unique_len[v - lo]};
+    };
+
+    // Pass 2a: size every range's rows.
+    offsets_.assign(n + 1, 0);
+    num_entries_ = 0;
+    const std::size_t ranges = bounds.size() - 1;
+    for (std::size_t r = 0; r < ranges; ++r) {
+        const std::size_t lo = bounds[r], hi = bounds[r + 1];
+        fill(lo, hi);
+        parallel::parallel_for(lo, hi, [&](std::size_t v) {
+            offsets_[v + 1] = row_bytes(static_cast<NodeId>(v), row(lo, v));
+        });
+        for (NodeId len : unique_len) num_entries_ += len;
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+    // Pass 2b: encode, last range first since it is still in the buffer.
+    bytes_.resize(offsets_.back());
+    for (std::size_t r = ranges; r-- > 0;) {
+        const std::size_t lo = bounds[r], hi = bounds[r + 1];
+        if (r + 1 != ranges) fill(lo, hi);
+        parallel::parallel_for(lo, hi, [&](std::size_t v) {
+            write_row(bytes_.data() + offsets_[v], static_cast<NodeId>(v), row(lo, v));
+        });
+    }
+}
+
+NodeId CompressedCsrGraph::neighbor(NodeId v, std::size_t i) const {
+    if (v >= num_nodes()) {
+        throw std::out_of_range("NodeId out of range in CompressedCsrGraph::neighbor");
+    }
+    Row row = open_row(v);
+    if (i >= row.degree) {
+        throw std::out_of_range("Neighbour index out of range in CompressedCsrGraph");
+    }
+    std::size_t b = i / kBlockSize;
+    const std::uint8_t* p = row.stream;
+    NodeId value;
+    if (b == 0) {
+        value = detail::decode_first(v, detail::read_varint(p));
+    } else {
+        BlockEntry entry = read_block(row.blocks, b - 1);
+        p = row.stream + entry.byte_offset;
+        detail::read_varint(p);
+        value = entry.value;
+    }
+    for (std::size_t k = b * kBlockSize; k < i; ++k) {
+        value += static_cast<NodeId>(detail::read_varint(p)) + 1;
+    }
+    return value;
+}
+
+bool CompressedCsrGraph::has_edge(NodeId u, NodeId v) const {
+    if (u >= num_nodes() || v >= num_nodes()) {
+        throw std::out_of_range("NodeId out of range in CompressedCsrGraph::has_edge");
+    }
+    Row row = open_row(u);
+    if (row.degree == 0) return false;
+
+    // Binary search for the last indexed entry not greater than v.
+    std::size_t lo = 0, hi = num_blocks(row.degree);
+    while (lo < hi) {
+        std::size_t mid = (lo + hi) / 2;
+        if (read_block(row.blocks, mid).value <= v) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const std::uint8_t* p = row.stream;
+    NodeId value;
+    std::size_t index = lo * kBlockSize; // index of the entry decoding starts at
+    if (lo == 0) {
+        value = detail::decode_first(u, detail::read_varint(p));
+    } else {
+        BlockEntry entry = read_block(row.blocks, lo - 1);
+        p = row.stream + entry.byte_offset;
+        detail::read_varint(p);
+        value = entry.value;
+    }
+    std::size_t remaining = std::min(row.degree - index, kBlockSize);
+    while (value < v && --remaining != 0) {
+        value += static_cast<NodeId>(detail::read_varint(p)) + 1;
+    }
+    return value == v;
+}
+
+} // namespace graph
+} // namespace tangle
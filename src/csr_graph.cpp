@@ -0,0 +1,108 @@
+#include "tangle/csr_graph.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace tangle {
+namespace graph {
+
+CsrGraph::CsrGraph(const PpiGraph& graph)
+    : CsrGraph(graph.num_nodes(), graph.edges()) {}
+
+CsrGraph::CsrGraph(std::size_t num_nodes, const std::vector<Edge>& edges) {
+    // 1. Count both directions of every non-loop edge.
+    std::vector<EdgeId> counts(num_nodes + 1, 0);
+    for (const auto& e : edges) {
+        if (e.u >= num_nodes || e.v >= num_nodes) {
+            throw std::out_of_range("NodeId out of range in CsrGraph");
+        }
+        if (e.u == e.v) continue;
+        counts[e.u + 1]++;
+        counts[e.v + 1]++;
+    }
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+    // 2. Scatter into a raw (unsorted, possibly duplicated) CSR.
+    std::vector<EdgeId> cursor(counts.begin(), counts.end() - 1);
+    std::vector<std::pair<NodeId, Weight>> raw(counts.back());
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        raw[cursor[e.u]++] = {e.v, e.weight};
+        raw[cursor[e.v]++] = {e.u, e.weight};
+    }
+
+    // 3. Sort each row and collapse duplicates (max weight wins).
+    std::vector<EdgeId> unique_len(num_nodes, 0);
+    parallel::parallel_for(0, num_nodes, [&](std::size_t v) {
+        auto first = raw.begin() + counts[v];
+        auto last = raw.begin() + counts[v + 1];
+        std::sort(first, last);
+        auto out = first;
+        for (auto it = first; it != last; ++it) {
+            if (out != first && (out - 1)->first == it->first) {
+                (out - 1)->second = std::max((out - 1)->second, it->second);
+            } else {
+                *out++ = *it;
+            }
+        }
+        unique_len[v] = static_cast<EdgeId>(out - first);
+    });
+
+    // 4. Compact into the final arrays.
+    offsets_.assign(num_nodes + 1, 0);
+    for (std::size_t v = 0; v < num_nodes; ++v) {
+        offsets_[v + 1] = offsets_[v] + unique_len[v];
+    }
+    targets_.resize(offsets_.back());
+    weights_.resize(offsets_.back());
+    parallel::parallel_for(0, num_nodes, [&](std::size_t v) {
+        EdgeId src = counts[v];
+        for (EdgeId i = offsets_[v]; i < offsets_[v + 1]; ++i, ++src) {
+            targets_[i] = raw[src].first;
+            weights_[i] = raw[src].second;
+        }
+    });
+}
+
+CsrGraph CsrGraph::permute(const std::vector<NodeId>& new_id) const {
+    const std::size_t n = num_nodes();
+    if (new_id.size() != n) {
+        throw std::invalid_argument("CsrGraph::permute: permutation size does not match node count");
+    }
+    std::vector<NodeId> old_id(n, static_cast<NodeId>(n));
+    for (NodeId v = 0; v < n; ++v) {
+        if (new_id[v] >= n || old_id[new_id[v]] != n) {
+            throw std::invalid_argument("CsrGraph::permute: not a permutation");
+        }
+        old_id[new_id[v]] = v;
+    }
+
+    CsrGraph out;
+    out.offsets_.assign(n + 1, 0);
+    for (NodeId v = 0; v < n; ++v) {
+        out.offsets_[v + 1] = out.offsets_[v] + degree(old_id[v]);
+    }
+    out.targets_.resize(targets_.size());
+    out.weights_.resize(weights_.size());
+    parallel::parallel_for(0, n, [&](std::size_t v) {
+        NodeId src = old_id[v];
+        std::vector<std::pair<NodeId, Weight>> row;
+        row.reserve(degree(src));
+        for (EdgeId i = offsets_[src]; i < offsets_[src + 1]; ++i) {
+            row.emplace_back(new_id[targets_[i]], weights_[i]);
+        }
+        std::sort(row.begin(), row.end());
+        EdgeId dst = out.offsets_[v];
+        for (const auto& [u, w] : row) {
+            out.targets_[dst] = u;
+            out.weights_[dst] = w;
+            ++dst;
+        }
+    });
+    return out;
+}
+
+} // namespace graph
+} // namespace tangle
@@ -1,47 +1,172 @@
 #include "tangle/export/sbml_exporter.hpp"
-#include <fstream>
+#include "tangle/io/output_file.hpp"
+#include "tangle/parallel.hpp"
 #include <stdexcept>
+#include <vector>
 
 namespace tangle {
 namespace export_ {
 
-void save_to_sbml(const graph::PpiGraph& graph, const std::string& filepath) {
-    std::ofstream outfile(filepath);
-    if (!outfile.is_open()) {
-        throw std::runtime_error("Could not open SBML file for writing: " + filepath);
+namespace {
+
+// Appends `text` with the five XML special characters escaped, for use in
+// attribute values.
+void append_xml_escaped(io::TextBuffer& out, std::string_view text) {
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char* entity = nullptr;
+        switch (text[i]) {
+        case '&': entity = "&amp;"; break;
+        case '<': entity = "&lt;"; break;
+        case '>': entity = "&gt;"; break;
+        case '"': entity = "&quot;"; break;
+        case '\'': entity = "&apos;"; break;
+        default: continue;
+        }
+        out << text.substr(start, i - start) << entity;
+        start = i + 1;
+    }
+    out << text.substr(start);
+}
+
+bool is_sid_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// SBML SId: a letter or '_', then letters, digits and '_'.
+bool is_valid_sid(std::string_view id) {
+    if (id.empty() || (id[0] >= '0' && id[0] <= '9')) return false;
+    for (char c : id) {
+        if (!is_sid_char(c)) return false;
     }
+    return true;
+}
+
+// Species ids for every node (see save_to_sbml). Rewritten ids are 's',
+// the NodeId and '_', so they can neither collide with each other nor with
+// an id kept as is.
+std::vector<std::string> species_ids(const std::vector<graph::Node>& nodes, unsigned int threads) {
+    std::vector<std::string> ids(nodes.size());
+    parallel::parallel_for(0, nodes.size(), [&](std::size_t v) {
+        const std::string& protein = nodes[v].protein_id;
+        // Also keep clear of the reaction / transition ids and fixed ids.
+        const bool reserved = (protein.size() > 1 && (protein[0] == 's' || protein[0] == 'r' || protein[0] == 't') &&
+                               protein[1] >= '0' && protein[1] <= '9') ||
+                              protein == "default" || protein == "tangle_ppi_network";
+        if (is_valid_sid(protein) && !reserved) {
+            ids[v] = protein;
+            return;
+        }
+        std::string id = "s" + std::to_string(v) + "_";
+        id.reserve(id.size() + protein.size());
+        for (char c : protein) id.push_back(is_sid_char(c) ? c : '_');
+        ids[v] = std::move(id);
+    }, 4096, threads);
+    return ids;
+}
+
+void write_level2(const graph::PpiGraph& graph, io::OutputFile& outfile, unsigned int threads) {
+    const auto& nodes = graph.nodes();
+    const auto& edges = graph.edges();
+    const std::vector<std::string> ids = species_ids(nodes, threads);
 
     outfile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
     outfile << "<sbml xmlns=\"http://www.sbml.org/sbml/level2/version5\" level=\"2\" version=\"5\">\n";
     outfile << "  <model id=\"tangle_ppi_network\">\n";
-    
+
     outfile << "    <listOfCompartments>\n";
     outfile << "      <compartment id=\"default\" size=\"1\"/>\n";
     outfile << "    </listOfCompartments>\n";
 
     outfile << "    <listOfSpecies>\n";
-    for (const auto& node : graph.nodes()) {
-        outfile << "      <species id=\"" << node.protein_id << "\" name=\"" << node.protein_id << "\" compartment=\"default\" initialAmount=\"1\"/>\n";
-    }
+    io::write_records(outfile, nodes.size(), [&](std::size_t v, io::TextBuffer& out) {
+        out << "      <species id=\"" << ids[v] << "\" name=\"";
+        append_xml_escaped(out, nodes[v].protein_id);
+        out << "\" compartment=\"default\" initialAmount=\"1\"/>\n";
+    }, threads);
     outfile << "    </listOfSpecies>\n";
 
     outfile << "    <listOfReactions>\n";
-    int reaction_count = 0;
-    for (const auto& edge : graph.edges()) {
-        outfile << "      <reaction id=\"r" << reaction_count++ << "\" reversible=\"false\">\n";
-        outfile << "        <listOfReactants>\n";
-        outfile << "          <speciesReference species=\"" << graph.node(edge.u).protein_id << "\"/>\n";
-        outfile << "          <speciesReference species=\"" << graph.node(edge.v).protein_id << "\"/>\n";
-        outfile << "        </listOfReactants>\n";
-        outfile << "        <listOfProducts/>\n";
-        outfile << "        <kineticLaw/>\n";
-        outfile << "      </reaction>\n";
-    }
+    io::write_records(outfile, edges.size(), [&](std::size_t i, io::TextBuffer& out) {
+        out << "      <reaction id=\"r" << i << "\" reversible=\"false\">\n"
+            << "        <listOfReactants>\n"
+            << "          <speciesReference species=\"" << ids[edges[i].u] << "\"/>\n"
+            << "          <speciesReference species=\"" << ids[edges[i].v] << "\"/>\n"
+            << "        </listOfReactants>\n"
+            << "        <listOfProducts/>\n"
+            << "        <kineticLaw/>\n"
+            << "      </reaction>\n";
+    }, threads);
     outfile << "    </listOfReactions>\n";
 
     outfile << "  </model>\n";
     outfile << "</sbml>\n";
 }
 
-} // namespace export_ 
+void write_level3_qual(const graph::PpiGraph& graph, io::OutputFile& outfile, unsigned int threads) {
+    const auto& nodes = graph.nodes();
+    const auto& edges = graph.edges();
+    const std::vector<std::string> ids = species_ids(nodes, threads);
+
+    outfile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    outfile << "<sbml xmlns=\"http://www.sbml.org/sbml/level3/version1/core\" level=\"3\" version=\"1\"\n"
+            << "      xmlns:qual=\"http://www.sbml.org/sbml/level3/version1/qual/version1\" "
+               "qual:required=\"true\">\n";
+    outfile << "  <model id=\"tangle_ppi_network\">\n";
+
+    outfile << "    <listOfCompartments>\n";
+    outfile << "      <compartment id=\"default\" size=\"1\" constant=\"true\"/>\n";
+    outfile << "    </listOfCompartments>\n";
+
+    outfile << "    <qual:listOfQualitativeSpecies>\n";
+    io::write_records(outfile, nodes.size(), [&](std::size_t v, io::TextBuffer& out) {
+        out << "      <qual:qualitativeSpecies qual:id=\"" << ids[v] << "\" qual:name=\"";
+        append_xml_escaped(out, nodes[v].protein_id);
+        out << "\" qual:compartment=\"default\" qual:constant=\"false\"/>\n";
+    }, threads);
+    outfile << "    </qual:listOfQualitativeSpecies>\n";
+
+    outfile << "    <qual:listOfTransitions>\n";
+    io::write_records(outfile, edges.size(), [&](std::size_t i, io::TextBuffer& out) {
+        out << "      <qual:transition qual:id=\"t" << i << "\">\n"
+            << "        <qual:listOfInputs>\n"
+            << "          <qual:input qual:id=\"t" << i << "_in\" qual:qualitativeSpecies=\"" << ids[edges[i].u]
+            << "\" qual:transitionEffect=\"none\"/>\n"
+            << "        </qual:listOfInputs>\n"
+            << "        <qual:listOfOutputs>\n"
+            << "          <qual:output qual:id=\"t" << i << "_out\" qual:qualitativeSpecies=\"" << ids[edges[i].v]
+            << "\" qual:transitionEffect=\"assignmentLevel\"/>\n"
+            << "        </qual:listOfOutputs>\n"
+            << "        <qual:listOfFunctionTerms>\n"
+            << "          <qual:defaultTerm qual:resultLevel=\"0\"/>\n"
+            << "        </qual:listOfFunctionTerms>\n"
+            << "      </qual:transition>\n";
+    }, threads);
+    outfile << "    </qual:listOfTransitions>\n";
+
+    outfile << "  </model>\n";
+    outfile << "</sbml>\n";
+}
+
+} // namespace
+
+void save_to_sbml(const graph::PpiGraph& graph, const std::string& filepath) {
+    save_to_sbml(graph, filepath, SbmlOptions{});
+}
+
+void save_to_sbml(const graph::PpiGraph& graph, const std::string& filepath, const SbmlOptions& options) {
+    io::OutputFile outfile(filepath, 1 << 20, options.compression);
+    if (!outfile.is_open()) {
+        throw std::runtime_error("Could not open SBML file for writing: " + filepath);
+    }
+
+    if (options.format == SbmlFormat::Level3Qual) {
+        write_level3_qual(graph, outfile, options.threads);
+    } else {
+        write_level2(graph, outfile, options.threads);
+    }
+    outfile.close();
+}
+
+} // namespace export_
 } // namespace tangle
@@ -1,5 +1,8 @@
 #include "tangle/graph.hpp"
-#include <stdexcept> // For std::out_of_range
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept> // For std::out_of_range, std::invalid_argument
 
 namespace tangle {
 namespace graph {
@@ -69,5 +72,147 @@ void PpiGraph::ensure_adj_size() {
     }
 }
 
+PpiGraph induced_subgraph(const PpiGraph& graph, const std::vector<bool>& keep) {
+    if (keep.size() != graph.num_nodes()) {
+        throw std::invalid_argument("induced_subgraph: keep mask size does not match node count");
+    }
+
+    PpiGraph sub;
+    std::vector<NodeId> new_id(graph.num_nodes(), 0);
+    for (const auto& n : graph.nodes()) {
+        if (keep[n.id]) {
+            new_id[n.id] = sub.add_node(n.protein_id, n.gene_symbol);
+        }
+    }
+    for (const auto& e : graph.edges()) {
+        if (keep[e.u] && keep[e.v]) {
+            sub.add_edge(new_id[e.u], new_id[e.v], e.weight);
+        }
+    }
+    return sub;
+}
+
+namespace {
+
+struct KeyedEdge {
+    std::uint64_t key; // (min << 32) | max
+    Weight weight;
+};
+
+// Stable LSD radix sort on the low `key_bits` bits of the keys. Each pass
+// histograms one chunk per thread, turns the (digit, thread) counts into
+// scatter offsets and scatters every chunk independently.
+void radix_sort(std::vector<KeyedEdge>& items, unsigned int key_bits, unsigned int threads) {
+    constexpr unsigned int kDigitBits = 11;
+    constexpr std::size_t kBuckets = std::size_t{1} << kDigitBits;
+    constexpr std::size_t kMinPerThread = 1 << 16;
+
+    const std::size_t n = items.size();
+    if (threads == 0) threads = parallel::num_threads();
+    threads = static_cast<unsigned int>(
+        std::max<std::size_t>(1, std::min<std::size_t>(threads, n / kMinPerThread)));
+
+    std::vector<KeyedEdge> buffer(n);
+    std::vector<std::size_t> offsets(threads * kBuckets);
+    for (unsigned int shift = 0; shift < key_bits; shift += kDigitBits) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        parallel::for_each_chunk(0, n, [&](std::size_t lo, std::size_t hi, unsigned int t) {
+            std::size_t* count = offsets.data() + t * kBuckets;
+            for (std::size_t i = lo; i < hi; ++i) {
+                ++count[(items[i].key >> shift) & (kBuckets - 1)];
+            }
+        }, threads);
+
+        std::size_t total = 0;
+        for (std::size_t d = 0; d < kBuckets; ++d) {
+            for (unsigned int t = 0; t < threads; ++t) {
+                std::size_t c = offsets[t * kBuckets + d];
+                offsets[t * kBuckets + d] = total;
+                total += c;
+            }
+        }
+
+        parallel::for_each_chunk(0, n, [&](std::size_t lo, std::size_t hi, unsigned int t) {
+            std::size_t* next = offsets.data() + t * kBuckets;
+            for (std::size_t i = lo; i < hi; ++i) {
+                buffer[next[(items[i].key >> shift) & (kBuckets - 1)]++] = items[i];
+            }
+        }, threads);
+        items.swap(buffer);
+    }
+}
+
+} // namespace
+
+std::vector<Edge> canonicalize_edges(const std::vector<Edge>& edges, EdgeMerge merge,
+                                     unsigned int threads) {
+    std::vector<KeyedEdge> keyed;
+    keyed.reserve(edges.size());
+    NodeId max_id = 0;
+    for (const auto& e : edges) {
+        if (e.u == e.v) continue;
+        NodeId lo = std::min(e.u, e.v);
+        NodeId hi = std::max(e.u, e.v);
+        max_id = std::max(max_id, hi);
+        keyed.push_back({(static_cast<std::uint64_t>(lo) << 32) | hi, e.weight});
+    }
+
+    // Only the bits that can be non-zero need sorting passes.
+    unsigned int id_bits = 1;
+    while (id_bits < 32 && (static_cast<std::uint64_t>(max_id) >> id_bits) != 0) ++id_bits;
+    if (id_bits == 32) {
+        radix_sort(keyed, 64, threads);
+    } else {
+        for (auto& k : keyed) {
+            k.key = ((k.key >> 32) << id_bits) | (k.key & 0xffffffffu);
+        }
+        radix_sort(keyed, 2 * id_bits, threads);
+        for (auto& k : keyed) {
+            k.key = ((k.key >> id_bits) << 32) | (k.key & ((std::uint64_t{1} << id_bits) - 1));
+        }
+    }
+
+    std::vector<Edge> result;
+    for (std::size_t i = 0; i < keyed.size();) {
+        std::size_t j = i;
+        Weight w = keyed[i].weight;
+        Weight sum = 0.0;
+        for (; j < keyed.size() && keyed[j].key == keyed[i].key; ++j) {
+            w = std::max(w, keyed[j].weight);
+            sum += keyed[j].weight;
+        }
+        const auto count = static_cast<Weight>(j - i);
+        switch (merge) {
+            case EdgeMerge::Max: break;
+            case EdgeMerge::Sum: w = sum; break;
+            case EdgeMerge::Mean: w = sum / count; break;
+            case EdgeMerge::Count: w = count; break;
+        }
+        result.push_back({static_cast<NodeId>(keyed[i].key >> 32),
+                          static_cast<NodeId>(keyed[i].key & 0xffffffffu), w});
+        i = j;
+    }
+    return result;
+}
+
+PpiGraph collapse_multi_edges(const PpiGraph& graph, EdgeMerge merge, unsigned int threads) {
+    PpiGraph collapsed;
+    for (const auto& n : graph.nodes()) {
+        collapsed.add_node(n.protein_id, n.gene_symbol);
+    }
+    for (const auto& e : canonicalize_edges(graph.edges(), merge, threads)) {
+        collapsed.add_edge(e.u, e.v, e.weight);
+    }
+    return collapsed;
+}
+
+EdgeMerge parse_edge_merge(const std::string& name) {
+    if (name == "max") return EdgeMerge::Max;
+    if (name == "sum") return EdgeMerge::Sum;
+    if (name == "mean") return EdgeMerge::Mean;
+    if (name == "count") return EdgeMerge::Count;
+    throw std::invalid_argument("Unknown edge merge '" + name + "' (expected max, sum, mean or count)");
+}
+
 } // namespace graph
 } // namespace tangle
@@ -0,0 +1,120 @@
+#include "tangle/graph_overlay.hpp"
+#include <stdexcept>
+
+namespace tangle {
+namespace graph {
+
+void GraphOverlay::check_node(NodeId v) const {
+    if (v >= num_nodes()) {
+        throw std::out_of_range("NodeId out of range in GraphOverlay");
+    }
+}
+
+NodeId GraphOverlay::add_node() {
+    NodeId id = static_cast<NodeId>(num_nodes());
+    ++added_nodes_;
+    return id;
+}
+
+void GraphOverlay::remove_node(NodeId v) {
+    check_node(v);
+    if (is_removed(v)) return;
+
+    // Neighbours lose one degree each; collect them before v disappears.
+    std::vector<NodeId> nbrs;
+    for_each_neighbor(v, [&](NodeId u, Weight) { nbrs.push_back(u); });
+    for (NodeId u : nbrs) {
+        --degree_delta_[u];
+        erase_added(u, v);
+    }
+    added_edges_.erase(v);
+    degree_delta_.erase(v);
+
+    removed_nodes_.insert(std::upper_bound(removed_nodes_.begin(), removed_nodes_.end(), v), v);
+}
+
+void GraphOverlay::add_edge(NodeId u, NodeId v, Weight w) {
+    check_node(u);
+    check_node(v);
+    if (u == v) {
+        throw std::invalid_argument("GraphOverlay::add_edge: self-loops are not supported");
+    }
+    if (is_removed(u) || is_removed(v)) {
+        throw std::invalid_argument("GraphOverlay::add_edge: endpoint has been removed");
+    }
+    if (has_edge(u, v)) return;
+
+    added_edges_[u].emplace_back(v, w);
+    added_edges_[v].emplace_back(u, w);
+    ++degree_delta_[u];
+    ++degree_delta_[v];
+}
+
+void GraphOverlay::remove_edge(NodeId u, NodeId v) {
+    check_node(u);
+    check_node(v);
+    if (is_removed(u) || is_removed(v)) return;
+
+    if (erase_added(u, v)) {
+        erase_added(v, u);
+    } else if (!has_base_edge(u, v) || !removed_edges_.insert(edge_key(u, v)).second) {
+        return; // absent, or a base edge that is already hidden
+    }
+    --degree_delta_[u];
+    --degree_delta_[v];
+}
+
+bool GraphOverlay::has_base_edge(NodeId u, NodeId v) const {
+    if (u >= base_->num_nodes() || v >= base_->num_nodes()) return false;
+    NeighborRange nbrs = base_->neighbors(u);
+    return std::binary_search(nbrs.begin(), nbrs.end(), v);
+}
+
+// Removes v from u's list of added neighbours; returns whether it was there.
+bool GraphOverlay::erase_added(NodeId u, NodeId v) {
+    auto it = added_edges_.find(u);
+    if (it == added_edges_.end()) return false;
+    auto& list = it->second;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        if (list[i].first == v) {
+            list[i] = list.back();
+            list.pop_back();
+            if (list.empty()) added_edges_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GraphOverlay::has_edge(NodeId u, NodeId v) const {
+    check_node(u);
+    check_node(v);
+    if (is_removed(u) || is_removed(v)) return false;
+    if (has_base_edge(u, v) && !removed_edges_.count(edge_key(u, v))) return true;
+    auto it = added_edges_.find(u);
+    if (it == added_edges_.end()) return false;
+    for (const auto& [x, w] : it->second) {
+        if (x == v) return true;
+    }
+    return false;
+}
+
+std::size_t GraphOverlay::degree(NodeId v) const {
+    check_node(v);
+    if (is_removed(v)) return 0;
+    std::int64_t d = v < base_->num_nodes() ? static_cast<std::int64_t>(base_->degree(v)) : 0;
+    auto it = degree_delta_.find(v);
+    if (it != degree_delta_.end()) d += it->second;
+    return static_cast<std::size_t>(d);
+}
+
+void GraphOverlay::reset() {
+    added_nodes_ = 0;
+    removed_nodes_.clear();
+    removed_edges_.clear();
+    added_edges_.clear();
+    degree_delta_.clear();
+}
+
+} // namespace graph
+} // namespace tangle
@@ -1,48 +1,59 @@
 #include "tangle/io/biogrid_importer.hpp"
-#include <fstream>
-#include <sstream>
+#include "tangle/io/input_file.hpp"
+#include "tangle/io/line_blocks.hpp"
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 namespace tangle {
 namespace io {
 
+namespace {
+
+struct BiogridRow {
+    std::string_view protein1;
+    std::string_view protein2;
+};
+
+} // namespace
+
 graph::PpiGraph load_from_biogrid(const std::string& filepath, bool use_entrez_id) {
     graph::PpiGraph graph;
-    std::ifstream infile(filepath);
+    InputFile infile(filepath);
     if (!infile.is_open()) {
         throw std::runtime_error("Could not open BioGRID file: " + filepath);
     }
 
-    std::string line;
-    // Skip header
-    if (!std::getline(infile, line) || line.empty() || line[0] != '#') {
-        // This is not a standard biogrid file, but we can try to parse it anyway
-        infile.seekg(0);
-    }
-
-    while (std::getline(infile, line)) {
-        if (line.empty() || line[0] == '#') continue;
-
-        std::stringstream ss(line);
-        std::string item;
-        std::vector<std::string> columns;
-        while(std::getline(ss, item, '\t')) {
-            columns.push_back(item);
-        }
+    // The '#' header line, if present, is skipped with the other comments;
+    // no seeking back, so compressed input works too.
+    const std::size_t col1 = use_entrez_id ? 1 : 7;
+    const std::size_t col2 = use_entrez_id ? 2 : 8;
+    auto parse = [&](std::string_view line, std::vector<BiogridRow>& rows) {
+        if (line.empty() || line[0] == '#') return;
 
         // BioGRID format has many columns. We need at least 9 for official symbols.
-        if (columns.size() < 9) continue;
-
-        const std::string& protein1 = use_entrez_id ? columns[1] : columns[7];
-        const std::string& protein2 = use_entrez_id ? columns[2] : columns[8];
+        std::string_view columns[9];
+        std::size_t count = 0;
+        std::size_t start = 0;
+        while (count < 9) {
+            std::size_t end = line.find('\t', start);
+            columns[count++] = line.substr(start, end == std::string_view::npos ? end : end - start);
+            if (end == std::string_view::npos) break;
+            start = end + 1;
+        }
+        if (count < 9) return;
 
-        if (protein1 == "-" || protein2 == "-") continue;
+        std::string_view protein1 = columns[col1];
+        std::string_view protein2 = columns[col2];
+        if (protein1 == "-" || protein2 == "-") return;
+        rows.push_back({protein1, protein2});
+    };
 
-        NodeId u = graph.get_or_add_node(protein1);
-        NodeId v = graph.get_or_add_node(protein2);
+    parse_line_blocks<BiogridRow>(infile, parse, [&](const BiogridRow& row) {
+        NodeId u = graph.get_or_add_node(ProteinId(row.protein1));
+        NodeId v = graph.get_or_add_node(ProteinId(row.protein2));
         graph.add_edge(u, v);
-    }
+    });
 
     if (graph.num_nodes() == 0) {
         throw std::runtime_error("No nodes were loaded from the BioGRID file. Check file format.");
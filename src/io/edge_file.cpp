@@ -0,0 +1,180 @@
+#include "tangle/io/edge_file.hpp"
+#include "tangle/io/input_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace tangle {
+namespace io {
+
+namespace {
+
+constexpr char kMagic[8] = {'T', 'N', 'G', 'L', 'E', 'D', 'G', '1'};
+
+struct Header {
+    char magic[8];
+    std::uint64_t num_nodes;
+    std::uint64_t num_edges;
+};
+
+} // namespace
+
+EdgeFileWriter::EdgeFileWriter(const std::string& path, std::size_t buffer_edges)
+    : out_(path, std::ios::binary | std::ios::trunc), capacity_(std::max<std::size_t>(buffer_edges, 1)) {
+    if (!out_.is_open()) {
+        throw std::runtime_error("Could not open file for writing edge file: " + path);
+    }
+    Header header{};
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header)); // patched in finish()
+    buffer_.reserve(capacity_);
+}
+
+EdgeFileWriter::~EdgeFileWriter() {
+    // Deliberately not finish(): a writer destroyed early (e.g. while an
+    // exception unwinds a half-read input) keeps its zeroed placeholder
+    // header, so the partial file fails to open later instead of passing
+    // for a complete one.
+}
+
+void EdgeFileWriter::add_edge(NodeId u, NodeId v, Weight w) {
+    if (finished_) {
+        throw std::logic_error("EdgeFileWriter::add_edge called after finish()");
+    }
+    buffer_.push_back({u, v, w});
+    num_nodes_ = std::max<std::size_t>(num_nodes_, std::max(u, v) + std::size_t{1});
+    ++num_edges_;
+    if (buffer_.size() == capacity_) flush();
+}
+
+void EdgeFileWriter::flush() {
+    out_.write(reinterpret_cast<const char*>(buffer_.data()),
+               static_cast<std::streamsize>(buffer_.size() * sizeof(graph::Edge)));
+    buffer_.clear();
+}
+
+void EdgeFileWriter::finish(std::size_t num_nodes) {
+    if (finished_) return;
+    flush();
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.num_nodes = std::max(num_nodes_, num_nodes);
+    header.num_edges = num_edges_;
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out_.close();
+    finished_ = true;
+    if (!out_) {
+        throw std::runtime_error("Failed to write edge file");
+    }
+}
+
+EdgeStream::EdgeStream(const std::string& path, std::size_t batch_edges)
+    : path_(path), batch_edges_(std::max<std::size_t>(batch_edges, 1)) {
+    std::ifstream in(path_, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open edge file: " + path_);
+    }
+    Header header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a tangle edge file: " + path_);
+    }
+    num_nodes_ = static_cast<std::size_t>(header.num_nodes);
+    num_edges_ = static_cast<std::size_t>(header.num_edges);
+}
+
+std::ifstream EdgeStream::open_at_edges() const {
+    std::ifstream in(path_, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open edge file: " + path_);
+    }
+    in.seekg(sizeof(Header));
+    return in;
+}
+
+bool is_edge_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(kMagic)];
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+void save_edge_file(const graph::PpiGraph& graph, const std::string& path) {
+    EdgeFileWriter writer(path);
+    for (const auto& e : graph.edges()) writer.add_edge(e.u, e.v, e.weight);
+    writer.finish(graph.num_nodes());
+
+    std::vector<ProteinId> names;
+    names.reserve(graph.num_nodes());
+    for (const auto& n : graph.nodes()) names.push_back(n.protein_id);
+    save_node_table(names, path);
+}
+
+std::vector<ProteinId> convert_edgelist(const std::string& text_path, const std::string& edge_path,
+                                        bool weighted, char delimiter) {
+    InputFile in(text_path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open edgelist file: " + text_path);
+    }
+
+    std::vector<ProteinId> names;
+    std::unordered_map<ProteinId, NodeId> index;
+    auto id_of = [&](const std::string& name) {
+        auto [it, inserted] = index.emplace(name, static_cast<NodeId>(names.size()));
+        if (inserted) names.push_back(name);
+        return it->second;
+    };
+
+    EdgeFileWriter writer(edge_path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::size_t first = line.find(delimiter);
+        if (first == std::string::npos) {
+            throw std::runtime_error("Malformed edgelist line: " + line);
+        }
+        std::size_t second = line.find(delimiter, first + 1);
+        std::string u = line.substr(0, first);
+        std::string v = line.substr(first + 1, second == std::string::npos ? std::string::npos
+                                                                           : second - first - 1);
+        Weight weight = 1.0;
+        if (weighted) {
+            if (second == std::string::npos) {
+                throw std::runtime_error("Weighted edgelist expects weight, but none found: " + line);
+            }
+            try {
+                weight = std::stod(line.substr(second + 1));
+            } catch (const std::exception&) {
+                throw std::runtime_error("Invalid weight format in edgelist: " + line);
+            }
+        }
+        NodeId uid = id_of(u);
+        NodeId vid = id_of(v);
+        writer.add_edge(uid, vid, weight);
+    }
+    writer.finish(names.size());
+    save_node_table(names, edge_path);
+    return names;
+}
+
+void save_node_table(const std::vector<ProteinId>& names, const std::string& edge_path) {
+    std::ofstream out(edge_path + ".nodes");
+    if (!out.is_open()) {
+        throw std::runtime_error("Could not open file for writing node table: " + edge_path + ".nodes");
+    }
+    for (const auto& name : names) out << name << "\n";
+}
+
+std::vector<ProteinId> load_node_table(const std::string& edge_path) {
+    std::ifstream in(edge_path + ".nodes");
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open node table: " + edge_path + ".nodes");
+    }
+    std::vector<ProteinId> names;
+    std::string line;
+    while (std::getline(in, line)) names.push_back(line);
+    return names;
+}
+
+} // namespace io
+} // namespace tangle
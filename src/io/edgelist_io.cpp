@@ -1,4 +1,6 @@
 #include "tangle/io/edgelist_io.hpp"
+#include "tangle/io/input_file.hpp"
+#include "tangle/io/output_file.hpp"
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -8,7 +10,7 @@ namespace io {
 
 graph::PpiGraph load_edgelist(const std::string& filepath, bool weighted, char delimiter) {
     graph::PpiGraph graph;
-    std::ifstream infile(filepath);
+    InputFile infile(filepath);
     if (!infile.is_open()) {
         throw std::runtime_error("Could not open edgelist file: " + filepath);
     }
@@ -50,19 +52,33 @@ graph::PpiGraph load_edgelist(const std::string& filepath, bool weighted, char d
 }
 
 void save_edgelist(const graph::PpiGraph& graph, const std::string& filepath, bool weighted, char delimiter) {
-    std::ofstream outfile(filepath);
+    save_edgelist(graph, graph.edges(), filepath, weighted, delimiter);
+}
+
+void save_edgelist(const graph::PpiGraph& graph, const std::vector<graph::Edge>& edges,
+                   const std::string& filepath, bool weighted, char delimiter) {
+    OutputFile outfile(filepath);
     if (!outfile.is_open()) {
         throw std::runtime_error("Could not open file for writing edgelist: " + filepath);
     }
 
-    for (const auto& edge : graph.edges()) {
-        outfile << graph.node(edge.u).protein_id << delimiter
-                << graph.node(edge.v).protein_id;
-        if (weighted) {
-            outfile << delimiter << edge.weight;
+    // Checked once here so the formatting threads can index nodes directly.
+    const auto& nodes = graph.nodes();
+    for (const auto& edge : edges) {
+        if (edge.u >= nodes.size() || edge.v >= nodes.size()) {
+            throw std::out_of_range("NodeId out of range in save_edgelist()");
         }
-        outfile << "\n";
     }
+
+    write_records(outfile, edges.size(), [&](std::size_t i, TextBuffer& out) {
+        const auto& edge = edges[i];
+        out << nodes[edge.u].protein_id << delimiter << nodes[edge.v].protein_id;
+        if (weighted) {
+            out << delimiter << edge.weight;
+        }
+        out << '\n';
+    });
+    outfile.close();
 }
 
 } // namespace io
@@ -0,0 +1,312 @@
+#include "tangle/io/input_file.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef TANGLE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef TANGLE_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace tangle {
+namespace io {
+
+namespace {
+
+constexpr std::size_t kReadBytes = 1 << 16; // compressed bytes read per refill
+
+const char* compression_name(Compression c) {
+    switch (c) {
+    case Compression::Gzip: return "gzip";
+    case Compression::Zstd: return "zstd";
+    default: return "plain";
+    }
+}
+
+// Inflates a compressed file into caller buffers. read() fills `dst` as far
+// as it can and returns 0 once the input is exhausted.
+class Decoder {
+public:
+    virtual ~Decoder() = default;
+    virtual std::size_t read(char* dst, std::size_t capacity) = 0;
+};
+
+#ifdef TANGLE_HAVE_ZLIB
+class GzipDecoder : public Decoder {
+public:
+    GzipDecoder(std::ifstream& in, const std::string& path) : in_(in), path_(path), input_(kReadBytes) {
+        // 15 + 32: largest window, accept both gzip and zlib headers.
+        if (inflateInit2(&zs_, 15 + 32) != Z_OK) {
+            throw std::runtime_error("Could not initialise zlib for: " + path_);
+        }
+    }
+    ~GzipDecoder() override { inflateEnd(&zs_); }
+
+    std::size_t read(char* dst, std::size_t capacity) override {
+        zs_.next_out = reinterpret_cast<Bytef*>(dst);
+        zs_.avail_out = static_cast<uInt>(capacity);
+        while (zs_.avail_out > 0) {
+            if (zs_.avail_in == 0 && !eof_) refill();
+            const uInt before = zs_.avail_out;
+            int ret = inflate(&zs_, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END) {
+                // Concatenated members (e.g. bgzip output) continue after a reset.
+                member_done_ = true;
+                inflateReset(&zs_);
+            } else if (ret == Z_OK) {
+                member_done_ = false;
+            } else if (ret != Z_BUF_ERROR) {
+                throw std::runtime_error("Corrupt gzip data in: " + path_);
+            }
+            if (eof_ && zs_.avail_in == 0 && zs_.avail_out == before) {
+                if (!member_done_) throw std::runtime_error("Truncated gzip file: " + path_);
+                break;
+            }
+        }
+        return capacity - zs_.avail_out;
+    }
+
+private:
+    std::ifstream& in_;
+    std::string path_;
+    std::vector<char> input_;
+    z_stream zs_{};
+    bool eof_ = false;
+    bool member_done_ = false;
+
+    void refill() {
+        in_.read(input_.data(), static_cast<std::streamsize>(input_.size()));
+        zs_.next_in = reinterpret_cast<Bytef*>(input_.data());
+        zs_.avail_in = static_cast<uInt>(in_.gcount());
+        if (zs_.avail_in == 0) eof_ = true;
+    }
+};
+#endif
+
+#ifdef TANGLE_HAVE_ZSTD
+class ZstdDecoder : public Decoder {
+public:
+    ZstdDecoder(std::ifstream& in, const std::string& path)
+        : in_(in), path_(path), input_(kReadBytes), ds_(ZSTD_createDStream()) {
+        if (ds_ == nullptr || ZSTD_isError(ZSTD_initDStream(ds_))) {
+            ZSTD_freeDStream(ds_);
+            throw std::runtime_error("Could not initialise zstd for: " + path_);
+        }
+    }
+    ~ZstdDecoder() override { ZSTD_freeDStream(ds_); }
+
+    std::size_t read(char* dst, std::size_t capacity) override {
+        ZSTD_outBuffer out{dst, capacity, 0};
+        while (out.pos < out.size) {
+            if (in_buf_.pos == in_buf_.size && !eof_) refill();
+            const std::size_t before = out.pos;
+            const std::size_t consumed = in_buf_.pos;
+            std::size_t ret = ZSTD_decompressStream(ds_, &out, &in_buf_);
+            if (ZSTD_isError(ret)) {
+                throw std::runtime_error("Corrupt zstd data in " + path_ + ": " + ZSTD_getErrorName(ret));
+            }
+            const bool progress = out.pos != before || in_buf_.pos != consumed;
+            // 0 once a frame is fully decoded and flushed. A call that makes
+            // no progress reports the next frame's header size instead.
+            if (progress) frame_pending_ = ret != 0;
+            if (eof_ && in_buf_.pos == in_buf_.size && !progress) {
+                if (frame_pending_) throw std::runtime_error("Truncated zstd file: " + path_);
+                break;
+            }
+        }
+        return out.pos;
+    }
+
+private:
+    std::ifstream& in_;
+    std::string path_;
+    std::vector<char> input_;
+    ZSTD_DStream* ds_;
+    ZSTD_inBuffer in_buf_{nullptr, 0, 0};
+    bool eof_ = false;
+    bool frame_pending_ = false;
+
+    void refill() {
+        in_.read(input_.data(), static_cast<std::streamsize>(input_.size()));
+        in_buf_ = {input_.data(), static_cast<std::size_t>(in_.gcount()), 0};
+        if (in_buf_.size == 0) eof_ = true;
+    }
+};
+#endif
+
+std::unique_ptr<Decoder> make_decoder(Compression c, std::ifstream& in, const std::string& path) {
+#ifdef TANGLE_HAVE_ZLIB
+    if (c == Compression::Gzip) return std::make_unique<GzipDecoder>(in, path);
+#endif
+#ifdef TANGLE_HAVE_ZSTD
+    if (c == Compression::Zstd) return std::make_unique<ZstdDecoder>(in, path);
+#endif
+    throw std::logic_error(std::string("No decoder for ") + compression_name(c) + " input");
+}
+
+// Single-producer, single-consumer stream buffer. A background thread fills
+// the slots of a ring with decompressed bytes; underflow() hands the next
+// full slot to the reader and releases the one it just finished. A
+// decoding error is rethrown to the reader after the chunks decoded
+// before it.
+class DecompressingBuf : public std::streambuf {
+public:
+    DecompressingBuf(std::unique_ptr<std::ifstream> file, std::unique_ptr<Decoder> decoder,
+                     std::size_t chunk_bytes, std::size_t chunks)
+        : file_(std::move(file)), decoder_(std::move(decoder)),
+          slots_(chunks, std::vector<char>(chunk_bytes)), sizes_(chunks, 0) {
+        producer_ = std::thread([this] { produce(); });
+    }
+
+    ~DecompressingBuf() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        producer_.join();
+    }
+
+protected:
+    int_type underflow() override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (holding_) {
+            holding_ = false;
+            head_ = (head_ + 1) % slots_.size();
+            --filled_;
+            cv_.notify_all();
+        }
+        cv_.wait(lock, [&] { return filled_ > 0 || done_; });
+        if (filled_ == 0) {
+            setg(nullptr, nullptr, nullptr);
+            if (error_) std::rethrow_exception(error_);
+            return traits_type::eof();
+        }
+        holding_ = true;
+        char* data = slots_[head_].data();
+        setg(data, data, data + sizes_[head_]);
+        return traits_type::to_int_type(*data);
+    }
+
+private:
+    std::unique_ptr<std::ifstream> file_;
+    std::unique_ptr<Decoder> decoder_;
+    std::vector<std::vector<char>> slots_;
+    std::vector<std::size_t> sizes_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::size_t head_ = 0;   // slot the reader holds or takes next
+    std::size_t tail_ = 0;   // slot the producer fills next
+    std::size_t filled_ = 0; // full slots, including the one the reader holds
+    bool holding_ = false;
+    bool done_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread producer_;
+
+    void produce() {
+        try {
+            for (;;) {
+                std::size_t slot;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [&] { return filled_ < slots_.size() || stop_; });
+                    if (stop_) return;
+                    slot = tail_;
+                }
+                // The slot is not visible to the reader until published below.
+                std::size_t n = decoder_->read(slots_[slot].data(), slots_[slot].size());
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (n == 0) {
+                        done_ = true;
+                    } else {
+                        sizes_[slot] = n;
+                        tail_ = (tail_ + 1) % slots_.size();
+                        ++filled_;
+                    }
+                }
+                cv_.notify_all();
+                if (n == 0) return;
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                error_ = std::current_exception();
+                done_ = true;
+            }
+            cv_.notify_all();
+        }
+    }
+};
+
+} // namespace
+
+Compression detect_compression(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    unsigned char magic[4] = {0, 0, 0, 0};
+    in.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    std::streamsize n = in.gcount();
+    if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) return Compression::Gzip;
+    if (n == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+bool compression_supported(Compression c) {
+    switch (c) {
+    case Compression::None: return true;
+#ifdef TANGLE_HAVE_ZLIB
+    case Compression::Gzip: return true;
+#endif
+#ifdef TANGLE_HAVE_ZSTD
+    case Compression::Zstd: return true;
+#endif
+    default: return false;
+    }
+}
+
+InputFile::InputFile(const std::string& path, std::size_t chunk_bytes, std::size_t chunks)
+    : std::istream(nullptr), compression_(detect_compression(path)) {
+    if (compression_ == Compression::None) {
+        auto file = std::make_unique<std::filebuf>();
+        open_ = file->open(path, std::ios::in) != nullptr;
+        buf_ = std::move(file);
+    } else {
+        if (!compression_supported(compression_)) {
+            const std::string name = compression_name(compression_);
+            throw std::runtime_error(path + " is " + name + "-compressed, but tangle was built without " +
+                                     name + " support");
+        }
+        auto file = std::make_unique<std::ifstream>(path, std::ios::binary);
+        open_ = file->is_open();
+        if (open_) {
+            auto decoder = make_decoder(compression_, *file, path);
+            buf_ = std::make_unique<DecompressingBuf>(std::move(file), std::move(decoder),
+                                                      std::max<std::size_t>(chunk_bytes, 1),
+                                                      std::max<std::size_t>(chunks, 2));
+        }
+    }
+    rdbuf(buf_.get());
+    if (!open_) {
+        setstate(std::ios::failbit);
+    } else if (compression_ != Compression::None) {
+        // Let decoding errors raised inside underflow() reach the caller
+        // instead of ending the read like a clean EOF.
+        exceptions(std::ios::badbit);
+    }
+}
+
+InputFile::~InputFile() = default;
+
+} // namespace io
+} // namespace tangle
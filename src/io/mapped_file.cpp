@@ -0,0 +1,55 @@
+#include "tangle/io/mapped_file.hpp"
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TANGLE_HAVE_MMAP 1
+#endif
+
+namespace tangle {
+namespace io {
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef TANGLE_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ == 0) {
+            open_ = true;
+        } else {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(p);
+                mapped_ = true;
+                open_ = true;
+            }
+        }
+    }
+    ::close(fd);
+    if (open_) return;
+    size_ = 0;
+#endif
+    // Not mappable (e.g. a pipe): read it instead.
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return;
+    buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    open_ = true;
+}
+
+MappedFile::~MappedFile() {
+#ifdef TANGLE_HAVE_MMAP
+    if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+}
+
+} // namespace io
+} // namespace tangle
@@ -0,0 +1,159 @@
+#include "tangle/io/mitab_importer.hpp"
+#include "tangle/io/input_file.hpp"
+#include "tangle/io/line_blocks.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace tangle {
+namespace io {
+
+namespace {
+
+constexpr std::size_t kColumns = 15; // MITAB 2.5 columns, shared by later versions
+
+struct MitabRow {
+    std::string_view a;
+    std::string_view b;
+    Weight weight;
+};
+
+struct Entry {
+    std::string_view db;
+    std::string_view value;
+};
+
+// Splits off the first kColumns tab-separated fields; returns how many there are.
+std::size_t split_columns(std::string_view line, std::array<std::string_view, kColumns>& cols) {
+    std::size_t n = 0;
+    std::size_t start = 0;
+    while (n < kColumns) {
+        std::size_t end = line.find('\t', start);
+        if (end == std::string_view::npos) {
+            cols[n++] = line.substr(start);
+            break;
+        }
+        cols[n++] = line.substr(start, end - start);
+        start = end + 1;
+    }
+    return n;
+}
+
+std::string_view strip_quotes(std::string_view s) {
+    if (s.size() >= 2 && s.front() == '"' && s.back() == '"') return s.substr(1, s.size() - 2);
+    return s;
+}
+
+// Splits `db:value(description)`; a quoted value may contain ':' or '('.
+Entry parse_entry(std::string_view entry) {
+    std::size_t colon = entry.find(':');
+    if (colon == std::string_view::npos) return {};
+    std::string_view rest = entry.substr(colon + 1);
+    std::string_view value;
+    if (!rest.empty() && rest.front() == '"') {
+        std::size_t close = rest.find('"', 1);
+        value = rest.substr(1, close == std::string_view::npos ? std::string_view::npos : close - 1);
+    } else {
+        value = rest.substr(0, rest.find('('));
+    }
+    return {strip_quotes(entry.substr(0, colon)), value};
+}
+
+// Calls fn(entry) on each '|'-separated entry of a column, skipping '|'
+// inside quotes, until fn returns true. Returns whether it did.
+template <typename Fn>
+bool any_entry(std::string_view column, Fn&& fn) {
+    if (column.empty() || column == "-") return false;
+    std::size_t start = 0;
+    bool quoted = false;
+    for (std::size_t i = 0; i <= column.size(); ++i) {
+        if (i < column.size() && column[i] == '"') quoted = !quoted;
+        if (i == column.size() || (column[i] == '|' && !quoted)) {
+            if (fn(parse_entry(column.substr(start, i - start)))) return true;
+            start = i + 1;
+        }
+    }
+    return false;
+}
+
+bool has_term(std::string_view column, const std::vector<std::string>& terms) {
+    return any_entry(column, [&](const Entry& e) {
+        return std::find(terms.begin(), terms.end(), e.value) != terms.end();
+    });
+}
+
+// First id from `db` among the primary ids, then the alternative ids.
+std::string_view pick_id(std::string_view primary, std::string_view alternative,
+                         const std::string& db) {
+    std::string_view id;
+    auto match = [&](const Entry& e) {
+        if (e.value.empty() || (!db.empty() && e.db != db)) return false;
+        id = e.value;
+        return true;
+    };
+    if (any_entry(primary, match)) return id;
+    if (!db.empty() && any_entry(alternative, match)) return id;
+    return {};
+}
+
+// Values are views into the block buffer and not NUL-terminated, so copy
+// before strtod.
+bool parse_score(std::string_view text, double& score) {
+    char buf[64];
+    if (text.empty() || text.size() >= sizeof(buf)) return false;
+    std::memcpy(buf, text.data(), text.size());
+    buf[text.size()] = '\0';
+    char* end = nullptr;
+    score = std::strtod(buf, &end);
+    return end == buf + text.size();
+}
+
+} // namespace
+
+graph::PpiGraph load_from_mitab(const std::string& filepath, const MitabOptions& options) {
+    InputFile infile(filepath);
+    if (!infile.is_open()) {
+        throw std::runtime_error("Could not open MITAB file: " + filepath);
+    }
+
+    auto parse = [&](std::string_view line, std::vector<MitabRow>& rows) {
+        if (line.empty() || line[0] == '#') return;
+        std::array<std::string_view, kColumns> cols;
+        const std::size_t n = split_columns(line, cols);
+        if (n < 12) return; // through the interaction type column
+
+        if (!options.detection_methods.empty() && !has_term(cols[6], options.detection_methods)) return;
+        if (!options.interaction_types.empty() && !has_term(cols[11], options.interaction_types)) return;
+        if (!options.taxon.empty()) {
+            auto in_taxon = [&](const Entry& e) { return e.value == options.taxon; };
+            if (!any_entry(cols[9], in_taxon) || !any_entry(cols[10], in_taxon)) return;
+        }
+
+        Weight weight = 1.0;
+        if (!options.score_name.empty()) {
+            bool found = n == kColumns && any_entry(cols[14], [&](const Entry& e) {
+                return e.db == options.score_name && parse_score(e.value, weight);
+            });
+            if (!found || weight < options.min_score) return;
+        }
+
+        std::string_view a = pick_id(cols[0], cols[2], options.id_database);
+        std::string_view b = pick_id(cols[1], cols[3], options.id_database);
+        if (a.empty() || b.empty()) return;
+        rows.push_back({a, b, weight});
+    };
+
+    graph::PpiGraph graph;
+    parse_line_blocks<MitabRow>(infile, parse, [&](const MitabRow& row) {
+        NodeId u = graph.get_or_add_node(ProteinId(row.a));
+        NodeId v = graph.get_or_add_node(ProteinId(row.b));
+        graph.add_edge(u, v, row.weight);
+    }, options.threads, options.block_bytes);
+    return graph;
+}
+
+} // namespace io
+} // namespace tangle
@@ -0,0 +1,132 @@
+#include "tangle/io/output_file.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef TANGLE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef TANGLE_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace tangle {
+namespace io {
+
+namespace {
+
+#ifdef TANGLE_HAVE_ZLIB
+// One complete gzip member holding `text`.
+std::string gzip_member(std::string_view text, const std::string& path) {
+    z_stream zs{};
+    // 15 + 16: largest window, gzip header and trailer.
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("Could not initialise zlib for: " + path);
+    }
+    std::string out(deflateBound(&zs, static_cast<uLong>(text.size())), '\0');
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+    zs.avail_in = static_cast<uInt>(text.size());
+    zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    zs.avail_out = static_cast<uInt>(out.size());
+    const int rc = deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    if (rc != Z_STREAM_END) {
+        throw std::runtime_error("gzip compression failed for: " + path);
+    }
+    return out;
+}
+#endif
+
+#ifdef TANGLE_HAVE_ZSTD
+// One complete zstd frame holding `text`.
+std::string zstd_frame(std::string_view text, const std::string& path) {
+    std::string out(ZSTD_compressBound(text.size()), '\0');
+    const std::size_t n = ZSTD_compress(&out[0], out.size(), text.data(), text.size(), 3);
+    if (ZSTD_isError(n)) {
+        throw std::runtime_error("zstd compression failed for: " + path);
+    }
+    out.resize(n);
+    return out;
+}
+#endif
+
+} // namespace
+
+OutputFile::OutputFile(const std::string& path, std::size_t buffer_bytes, Compression compression)
+    : path_(path), capacity_(std::max<std::size_t>(buffer_bytes, 1)), compression_(compression) {
+    if (!compression_supported(compression_)) {
+        throw std::runtime_error("Cannot compress " + path + ": tangle was built without support for this format");
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ != nullptr) {
+        std::setvbuf(file_, nullptr, _IONBF, 0); // buffer_ is the only buffer
+        buffer_.reserve(capacity_ + 256);
+    }
+}
+
+OutputFile::~OutputFile() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() to see write errors.
+    }
+}
+
+std::string OutputFile::encode(std::string_view text) const {
+    switch (compression_) {
+#ifdef TANGLE_HAVE_ZLIB
+    case Compression::Gzip: return gzip_member(text, path_);
+#endif
+#ifdef TANGLE_HAVE_ZSTD
+    case Compression::Zstd: return zstd_frame(text, path_);
+#endif
+    default: return std::string(text);
+    }
+}
+
+void OutputFile::write(std::string_view text) {
+    if (buffer_.size() + text.size() < capacity_) {
+        buffer_ << text;
+        return;
+    }
+    flush();
+    if (compression_ == Compression::None) {
+        put(text);
+    } else if (!text.empty()) {
+        put(encode(text));
+    }
+}
+
+void OutputFile::write_encoded(std::string_view bytes) {
+    flush();
+    put(bytes);
+}
+
+void OutputFile::flush() {
+    if (file_ == nullptr || buffer_.size() == 0) return;
+    if (compression_ == Compression::None) {
+        put(buffer_.view());
+    } else {
+        put(encode(buffer_.view()));
+    }
+    buffer_.clear();
+}
+
+void OutputFile::put(std::string_view bytes) {
+    if (file_ != nullptr && !bytes.empty() && std::fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size()) {
+        failed_ = true;
+    }
+}
+
+void OutputFile::close() {
+    if (file_ == nullptr) return;
+    flush();
+    if (std::fclose(file_) != 0) failed_ = true;
+    file_ = nullptr;
+    if (failed_) {
+        throw std::runtime_error("Failed to write file: " + path_);
+    }
+}
+
+} // namespace io
+} // namespace tangle
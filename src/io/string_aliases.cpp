@@ -0,0 +1,309 @@
+#include "tangle/io/string_aliases.hpp"
+#include "tangle/io/input_file.hpp"
+#include "tangle/io/line_blocks.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace tangle {
+namespace io {
+
+namespace {
+
+constexpr std::uint32_t kMissing = static_cast<std::uint32_t>(-1);
+
+struct AliasRow {
+    std::string_view id;
+    std::string_view alias;
+};
+
+// Strings appended while streaming, deduplicated once loading is done.
+struct StringTable {
+    std::string text;
+    std::vector<std::uint64_t> offsets{0};
+
+    std::size_t size() const { return offsets.size() - 1; }
+    std::string_view at(std::size_t i) const {
+        return std::string_view(text).substr(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    std::uint32_t add(std::string_view s) {
+        text.append(s);
+        offsets.push_back(text.size());
+        return static_cast<std::uint32_t>(size() - 1);
+    }
+};
+
+// Writes the distinct strings of `table` in sorted order to text/offsets
+// and returns the new index of every old entry.
+std::vector<std::uint32_t> dedupe(const StringTable& table, std::string& text,
+                                  std::vector<std::uint64_t>& offsets) {
+    const std::size_t n = table.size();
+    std::vector<std::uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](std::uint32_t a, std::uint32_t b) { return table.at(a) < table.at(b); });
+
+    std::vector<std::uint32_t> remap(n);
+    text.clear();
+    offsets.assign(1, 0);
+    for (std::size_t k = 0; k < n; ++k) {
+        std::string_view s = table.at(order[k]);
+        if (k == 0 || s != table.at(order[k - 1])) {
+            text.append(s);
+            offsets.push_back(text.size());
+        }
+        remap[order[k]] = static_cast<std::uint32_t>(offsets.size() - 2);
+    }
+    return remap;
+}
+
+std::vector<std::string_view> keys_of(const std::string& text, const std::vector<std::uint64_t>& offsets) {
+    std::vector<std::string_view> keys(offsets.size() - 1);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = std::string_view(text).substr(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    return keys;
+}
+
+// Table index of every key, or kMissing. Keys go through the perfect hash
+// in batches (with prefetching) on all threads, then are checked against
+// the stored strings.
+template <typename NameFn>
+std::vector<std::uint32_t> lookup_all(const std::vector<ProteinId>& keys, const PerfectHash& hash,
+                                      NameFn&& name, unsigned int threads) {
+    constexpr std::size_t kBlock = 1024;
+    std::vector<std::uint32_t> hit(keys.size(), kMissing);
+    const std::size_t blocks = (keys.size() + kBlock - 1) / kBlock;
+    parallel::parallel_for(0, blocks, [&](std::size_t b) {
+        const std::size_t lo = b * kBlock;
+        const std::size_t hi = std::min(keys.size(), lo + kBlock);
+        std::string_view views[kBlock];
+        std::size_t found[kBlock];
+        for (std::size_t i = lo; i < hi; ++i) views[i - lo] = keys[i];
+        hash.find_many(views, hi - lo, found);
+        for (std::size_t i = lo; i < hi; ++i) {
+            std::size_t f = found[i - lo];
+            if (f != PerfectHash::npos && name(static_cast<std::uint32_t>(f)) == keys[i]) {
+                hit[i] = static_cast<std::uint32_t>(f);
+            }
+        }
+    }, 1, threads);
+    return hit;
+}
+
+// Shared by both translation directions: bulk lookups, then a pass that
+// collects targets in input order without duplicates. Duplicates are found
+// by sorting the collected targets, so the cost depends on the set size,
+// not on the size of the table.
+template <typename NameFn>
+std::vector<ProteinId> translate(const std::vector<std::uint32_t>& hit,
+                                 const std::vector<std::uint32_t>& offsets,
+                                 const std::vector<std::uint32_t>& targets,
+                                 NameFn&& name, bool first_only) {
+    std::vector<std::uint32_t> found;
+    for (std::uint32_t h : hit) {
+        if (h == kMissing) continue;
+        std::uint32_t lo = offsets[h];
+        std::uint32_t hi = offsets[h + 1];
+        if (first_only) hi = std::min(hi, lo + 1);
+        found.insert(found.end(), targets.begin() + lo, targets.begin() + hi);
+    }
+
+    // Keep the first occurrence of each target.
+    std::vector<std::uint32_t> order(found.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::uint32_t a, std::uint32_t b) { return found[a] < found[b]; });
+    std::vector<char> keep(found.size(), 0);
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        if (k == 0 || found[order[k]] != found[order[k - 1]]) keep[order[k]] = 1;
+    }
+
+    std::vector<ProteinId> out;
+    for (std::size_t i = 0; i < found.size(); ++i) {
+        if (keep[i]) out.emplace_back(name(found[i]));
+    }
+    return out;
+}
+
+} // namespace
+
+StringAliases::StringAliases(const std::string& filepath, const std::vector<std::string>& sources,
+                             const std::string& taxon, unsigned int threads) {
+    InputFile infile(filepath);
+    if (!infile.is_open()) {
+        throw std::runtime_error("Could not open STRING aliases file: " + filepath);
+    }
+    const std::string prefix = taxon.empty() ? "" : taxon + ".";
+
+    auto parse = [&](std::string_view line, std::vector<AliasRow>& rows) {
+        if (line.empty() || line[0] == '#') return;
+        std::size_t t1 = line.find('\t');
+        if (t1 == std::string_view::npos) return;
+        std::size_t t2 = line.find('\t', t1 + 1);
+        if (t2 == std::string_view::npos) return;
+        std::string_view id = line.substr(0, t1);
+        std::string_view alias = line.substr(t1 + 1, t2 - t1 - 1);
+        if (id.empty() || alias.empty()) return;
+        if (!prefix.empty() && id.substr(0, prefix.size()) != prefix) return;
+
+        if (!sources.empty()) {
+            std::string_view source_list = line.substr(t2 + 1);
+            source_list = source_list.substr(0, source_list.find('\t'));
+            bool wanted = false;
+            std::size_t start = 0;
+            while (!wanted && start <= source_list.size()) {
+                std::size_t end = std::min(source_list.find(' ', start), source_list.size());
+                wanted = std::find(sources.begin(), sources.end(),
+                                   source_list.substr(start, end - start)) != sources.end();
+                start = end + 1;
+            }
+            if (!wanted) return;
+        }
+        rows.push_back({id, alias});
+    };
+
+    // The file is grouped by protein, so consecutive rows usually share an id.
+    StringTable raw_ids;
+    StringTable raw_aliases;
+    std::vector<std::uint32_t> row_id;
+    parse_line_blocks<AliasRow>(infile, parse, [&](const AliasRow& row) {
+        if (row_id.empty() || raw_ids.at(row_id.back()) != row.id) {
+            row_id.push_back(raw_ids.add(row.id));
+        } else {
+            row_id.push_back(row_id.back());
+        }
+        raw_aliases.add(row.alias);
+    }, threads);
+
+    if (row_id.size() >= kMissing) {
+        throw std::length_error("Too many rows in STRING aliases file: " + filepath);
+    }
+    std::vector<std::uint32_t> id_remap = dedupe(raw_ids, id_text_, id_offsets_);
+    raw_ids = {};
+    std::vector<std::uint32_t> alias_remap = dedupe(raw_aliases, alias_text_, alias_offsets_);
+    raw_aliases = {};
+
+    // Protein -> aliases in file order (rows are scattered stably), with
+    // repeated pairs removed.
+    const std::size_t n_ids = num_proteins();
+    const std::size_t n_aliases = num_aliases();
+    std::vector<std::uint32_t> start(n_ids + 1, 0);
+    for (std::uint32_t r : row_id) start[id_remap[r] + 1]++;
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<std::uint32_t> scattered(row_id.size());
+    {
+        std::vector<std::uint32_t> cursor(start.begin(), start.end() - 1);
+        for (std::size_t r = 0; r < row_id.size(); ++r) {
+            scattered[cursor[id_remap[row_id[r]]]++] = alias_remap[r];
+        }
+    }
+    id_alias_offsets_.assign(n_ids + 1, 0);
+    id_aliases_.reserve(scattered.size());
+    for (std::size_t p = 0; p < n_ids; ++p) {
+        const auto row_start = id_aliases_.size();
+        for (std::uint32_t j = start[p]; j < start[p + 1]; ++j) {
+            if (std::find(id_aliases_.begin() + row_start, id_aliases_.end(), scattered[j]) == id_aliases_.end()) {
+                id_aliases_.push_back(scattered[j]);
+            }
+        }
+        id_alias_offsets_[p + 1] = static_cast<std::uint32_t>(id_aliases_.size());
+    }
+
+    // Alias -> proteins; scattering proteins in order keeps each row sorted.
+    alias_id_offsets_.assign(n_aliases + 1, 0);
+    for (std::uint32_t a : id_aliases_) alias_id_offsets_[a + 1]++;
+    std::partial_sum(alias_id_offsets_.begin(), alias_id_offsets_.end(), alias_id_offsets_.begin());
+    alias_ids_.resize(id_aliases_.size());
+    {
+        std::vector<std::uint32_t> cursor(alias_id_offsets_.begin(), alias_id_offsets_.end() - 1);
+        for (std::uint32_t p = 0; p < n_ids; ++p) {
+            for (std::uint32_t j = id_alias_offsets_[p]; j < id_alias_offsets_[p + 1]; ++j) {
+                alias_ids_[cursor[id_aliases_[j]]++] = p;
+            }
+        }
+    }
+
+    id_hash_ = PerfectHash(keys_of(id_text_, id_offsets_));
+    alias_hash_ = PerfectHash(keys_of(alias_text_, alias_offsets_));
+}
+
+std::uint32_t StringAliases::find_id(std::string_view string_id) const {
+    std::size_t i = id_hash_.find(string_id);
+    if (i == PerfectHash::npos || id(static_cast<std::uint32_t>(i)) != string_id) return kMissing;
+    return static_cast<std::uint32_t>(i);
+}
+
+std::uint32_t StringAliases::find_alias(std::string_view name) const {
+    std::size_t i = alias_hash_.find(name);
+    if (i == PerfectHash::npos || alias(static_cast<std::uint32_t>(i)) != name) return kMissing;
+    return static_cast<std::uint32_t>(i);
+}
+
+std::vector<std::string_view> StringAliases::aliases_of(std::string_view string_id) const {
+    std::vector<std::string_view> out;
+    std::uint32_t p = find_id(string_id);
+    if (p == kMissing) return out;
+    for (std::uint32_t j = id_alias_offsets_[p]; j < id_alias_offsets_[p + 1]; ++j) {
+        out.push_back(alias(id_aliases_[j]));
+    }
+    return out;
+}
+
+std::vector<std::string_view> StringAliases::proteins_with(std::string_view name) const {
+    std::vector<std::string_view> out;
+    std::uint32_t a = find_alias(name);
+    if (a == kMissing) return out;
+    for (std::uint32_t j = alias_id_offsets_[a]; j < alias_id_offsets_[a + 1]; ++j) {
+        out.push_back(id(alias_ids_[j]));
+    }
+    return out;
+}
+
+std::vector<ProteinId> StringAliases::to_aliases(const std::vector<ProteinId>& string_ids, bool first_only,
+                                                 unsigned int threads) const {
+    auto hit = lookup_all(string_ids, id_hash_, [&](std::uint32_t p) { return id(p); }, threads);
+    return translate(hit, id_alias_offsets_, id_aliases_,
+                     [&](std::uint32_t a) { return ProteinId(alias(a)); }, first_only);
+}
+
+std::vector<ProteinId> StringAliases::to_string_ids(const std::vector<ProteinId>& aliases, bool first_only,
+                                                    unsigned int threads) const {
+    auto hit = lookup_all(aliases, alias_hash_, [&](std::uint32_t a) { return alias(a); }, threads);
+    return translate(hit, alias_id_offsets_, alias_ids_,
+                     [&](std::uint32_t p) { return ProteinId(id(p)); }, first_only);
+}
+
+graph::PpiGraph StringAliases::relabel(const graph::PpiGraph& graph, bool keep_unmapped) const {
+    const std::size_t n = graph.num_nodes();
+    std::vector<std::uint32_t> first_alias(n, kMissing);
+    parallel::parallel_for(0, n, [&](std::size_t v) {
+        std::uint32_t p = find_id(graph.node(static_cast<NodeId>(v)).protein_id);
+        if (p != kMissing && id_alias_offsets_[p] < id_alias_offsets_[p + 1]) {
+            first_alias[v] = id_aliases_[id_alias_offsets_[p]];
+        }
+    });
+
+    constexpr NodeId kDropped = static_cast<NodeId>(-1);
+    graph::PpiGraph out;
+    std::vector<NodeId> map(n, kDropped);
+    for (std::size_t v = 0; v < n; ++v) {
+        const graph::Node& node = graph.node(static_cast<NodeId>(v));
+        if (first_alias[v] != kMissing) {
+            map[v] = out.get_or_add_node(ProteinId(alias(first_alias[v])), node.gene_symbol);
+        } else if (keep_unmapped) {
+            map[v] = out.get_or_add_node(node.protein_id, node.gene_symbol);
+        }
+    }
+    for (const auto& e : graph.edges()) {
+        NodeId u = map[e.u];
+        NodeId v = map[e.v];
+        if (u == kDropped || v == kDropped || u == v) continue;
+        out.add_edge(u, v, e.weight);
+    }
+    return out;
+}
+
+} // namespace io
+} // namespace tangle
@@ -1,60 +1,76 @@
 #include "tangle/io/string_importer.hpp"
-#include <fstream>
-#include <sstream>
+#include "tangle/io/input_file.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <stdexcept>
-#include <vector>
-#include <iostream>
 
 namespace tangle {
 namespace io {
 
-graph::PpiGraph load_from_string(const std::string& filepath, double min_score, int score_column, char delimiter) {
-    graph::PpiGraph graph;
-    std::ifstream infile(filepath);
+std::size_t filter_string(const std::string& filepath, const StringEdgeSink& sink,
+                          double min_score, int score_column, char delimiter,
+                          bool one_direction) {
+    InputFile infile(filepath);
     if (!infile.is_open()) {
         throw std::runtime_error("Could not open STRING file: " + filepath);
     }
+    if (score_column < 1) {
+        throw std::invalid_argument("STRING score column must be 1-based");
+    }
+    const auto score_index = static_cast<std::size_t>(score_column - 1);
 
     std::string line;
     // Try to skip header, but it's not guaranteed to be correct.
     std::getline(infile, line);
 
+    std::size_t kept = 0;
+    std::string_view protein1, protein2;
     while (std::getline(infile, line)) {
         if (line.empty()) continue;
 
-        std::stringstream ss(line);
-        std::string item;
-        std::vector<std::string> columns;
-        while(std::getline(ss, item, delimiter)) {
-            columns.push_back(item);
-        }
-
-        if (columns.size() < score_column) {
-            continue;
-        }
-
-        const std::string& protein1 = columns[0];
-        const std::string& protein2 = columns[1];
-        double score = 0.0;
-        try {
-            score = std::stod(columns[score_column - 1]);
-        } catch(const std::exception& e) {
-            continue;
+        // Walk the columns up to the score without splitting the whole line.
+        const std::size_t last = std::max<std::size_t>(score_index, 1);
+        std::size_t start = 0;
+        std::size_t column = 0;
+        const char* score_text = nullptr;
+        bool complete = false;
+        while (start <= line.size()) {
+            std::size_t end = line.find(delimiter, start);
+            if (end == std::string::npos) end = line.size();
+            std::string_view field = std::string_view(line).substr(start, end - start);
+            if (column == 0) protein1 = field;
+            if (column == 1) protein2 = field;
+            if (column == score_index && !field.empty()) score_text = field.data();
+            if (column == last) {
+                complete = true;
+                break;
+            }
+            ++column;
+            start = end + 1;
         }
+        if (!complete || score_text == nullptr) continue;
 
-        if (score >= min_score) {
-            NodeId u = graph.get_or_add_node(protein1);
-            NodeId v = graph.get_or_add_node(protein2);
-            graph.add_edge(u, v, score);
-        }
-    }
+        char* parsed_end = nullptr;
+        double score = std::strtod(score_text, &parsed_end);
+        if (parsed_end == score_text) continue;
 
-    if (graph.num_nodes() == 0) {
-        // Don't throw, as it could be a valid empty graph
+        if (score < min_score) continue;
+        if (one_direction && protein1 > protein2) continue;
+        sink(protein1, protein2, score);
+        ++kept;
     }
+    return kept;
+}
 
+graph::PpiGraph load_from_string(const std::string& filepath, double min_score, int score_column, char delimiter) {
+    graph::PpiGraph graph;
+    filter_string(filepath, [&](std::string_view protein1, std::string_view protein2, double score) {
+        NodeId u = graph.get_or_add_node(ProteinId(protein1));
+        NodeId v = graph.get_or_add_node(ProteinId(protein2));
+        graph.add_edge(u, v, score);
+    }, min_score, score_column, delimiter);
     return graph;
 }
 
 } // namespace io
-} // namespace tangle
\ No newline at end of file
+} // namespace tangle
@@ -1,19 +1,38 @@
 #include "tangle/algo/centrality.hpp"
 #include "tangle/algo/community.hpp"
+#include "tangle/algo/components.hpp"
+#include "tangle/algo/kcore.hpp"
+#include "tangle/algo/null_model.hpp"
+#include "tangle/algo/proximity.hpp"
+#include "tangle/algo/quality.hpp"
+#include "tangle/algo/reorder.hpp"
+#include "tangle/algo/streaming.hpp"
 #include "tangle/annotate/annotation_db.hpp"
 #include "tangle/annotate/go_enrichment.hpp"
+#include "tangle/compressed_graph.hpp"
+#include "tangle/csr_graph.hpp"
 #include "tangle/export/sbml_exporter.hpp"
 #include "tangle/graph.hpp"
 #include "tangle/io/biogrid_importer.hpp"
+#include "tangle/io/edge_file.hpp"
 #include "tangle/io/edgelist_io.hpp"
+#include "tangle/io/mitab_importer.hpp"
+#include "tangle/io/output_file.hpp"
+#include "tangle/io/string_aliases.hpp"
 #include "tangle/io/string_importer.hpp"
+#include "tangle/scored_graph.hpp"
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <random>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #if TANGLE_WITH_JSON
@@ -42,10 +61,112 @@ void log_error(const std::string &message) {
 // CLI subcommand handlers
 // ----------------------------------------------------------------------------
 
+// Parses a comma-separated list of score thresholds, e.g. "400,700,900".
+std::vector<double> parse_thresholds(const std::string &list) {
+  std::vector<double> thresholds;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      thresholds.push_back(std::stod(item));
+    }
+  }
+  if (thresholds.empty()) {
+    throw std::invalid_argument("No score thresholds given");
+  }
+  return thresholds;
+}
+
+// "MI:0915,MI:0407" -> {"MI:0915", "MI:0407"}.
+std::vector<std::string> split_list(const std::string &list) {
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+// "human.edgelist" at 700 -> "human_700.edgelist".
+std::string threshold_path(const std::string &path, double threshold) {
+  std::ostringstream label;
+  label << threshold;
+  std::size_t dot = path.find_last_of('.');
+  std::size_t slash = path.find_last_of('/');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    return path + "_" + label.str();
+  }
+  return path.substr(0, dot) + "_" + label.str() + path.substr(dot);
+}
+
+// Filters a STRING file straight to the output without building a graph.
+// Text output needs no state at all; binary output interns protein ids.
+// Every passing row is written. With --string-symmetric the input is taken
+// to list each pair in both directions with the same score, and only the
+// protein1 < protein2 row of each pair is kept; files that list a pair once
+// would lose it, so this is opt-in.
+void stream_import_string(const std::map<std::string, std::string> &args,
+                          double min_score, int score_col, char delimiter) {
+  const std::string &infile = args.at("in");
+  const std::string &outfile = args.at("out");
+  bool one_direction = args.count("string-symmetric") > 0;
+  std::size_t kept = 0;
+
+  if (args.count("binary")) {
+    std::vector<tangle::ProteinId> names;
+    std::unordered_map<tangle::ProteinId, tangle::NodeId> index;
+    auto id_of = [&](std::string_view name) {
+      auto [it, inserted] = index.emplace(
+          tangle::ProteinId(name), static_cast<tangle::NodeId>(names.size()));
+      if (inserted) {
+        names.push_back(it->first);
+      }
+      return it->second;
+    };
+    tangle::io::EdgeFileWriter writer(outfile);
+    kept = tangle::io::filter_string(
+        infile,
+        [&](std::string_view p1, std::string_view p2, double score) {
+          writer.add_edge(id_of(p1), id_of(p2), score);
+        },
+        min_score, score_col, delimiter, one_direction);
+    writer.finish(names.size());
+    tangle::io::save_node_table(names, outfile);
+  } else {
+    tangle::io::OutputFile out(outfile);
+    if (!out.is_open()) {
+      throw std::runtime_error("Could not open file for writing edgelist: " +
+                               outfile);
+    }
+    bool weighted = args.count("weighted");
+    kept = tangle::io::filter_string(
+        infile,
+        [&](std::string_view p1, std::string_view p2, double score) {
+          out << p1 << '\t' << p2;
+          if (weighted) {
+            out << '\t' << score;
+          }
+          out << '\n';
+        },
+        min_score, score_col, delimiter, one_direction);
+    out.close();
+  }
+  log(1, "  -> Streamed " + std::to_string(kept) + " edges to '" + outfile +
+             "'.\n");
+}
+
 void handle_import(const std::map<std::string, std::string> &args) {
   if (args.find("in") == args.end() || args.find("out") == args.end()) {
     log_error("Usage: tangle import --in=<filepath> --out=<filepath> "
-              "[--format=string|biogrid] [--score=<min_score>]\n");
+              "[--format=string|biogrid|mitab] [--score=<min_score>] "
+              "[--merge=max|sum|mean|count|none] [--weighted] [--kcore=<k>] "
+              "[--lcc] [--stream [--binary] [--string-symmetric]] "
+              "[--thresholds=<s1,s2,...>] "
+              "[--id-db=<db>] [--types=<MI ids>] [--methods=<MI ids>] "
+              "[--taxon=<taxid>] [--score-name=<name>]\n");
     return;
   }
 
@@ -56,12 +177,29 @@ void handle_import(const std::map<std::string, std::string> &args) {
     format = args.at("format");
   }
 
+  // Checked up front so a typo does not surface only after the full parse.
+  std::string merge = args.count("merge") ? args.at("merge") : "max";
+  tangle::graph::EdgeMerge edge_merge = tangle::graph::EdgeMerge::Max;
+  if (merge != "none") {
+    try {
+      edge_merge = tangle::graph::parse_edge_merge(merge);
+    } catch (const std::invalid_argument &) {
+      log_error("Error: Unknown merge '" + merge +
+                "'. Supported: max, sum, mean, count, none\n");
+      return;
+    }
+  }
+
   tangle::graph::PpiGraph graph;
   if (format == "string") {
     double min_score = 700.0;
     if (args.count("score")) {
       min_score = std::stod(args.at("score"));
     }
+    if (args.count("thresholds")) {
+      auto thresholds = parse_thresholds(args.at("thresholds"));
+      min_score = *std::min_element(thresholds.begin(), thresholds.end());
+    }
     int score_col = 10;
     if (args.count("score-col")) {
       score_col = std::stoi(args.at("score-col"));
@@ -80,29 +218,126 @@ void handle_import(const std::map<std::string, std::string> &args) {
                std::to_string(score_col) + ", delimiter '" +
                (delimiter == '\t' ? "\\t" : std::string(1, delimiter)) +
                "'...\n");
+    if (args.count("stream")) {
+      if (args.count("kcore") || args.count("lcc")) {
+        log_error("Error: --kcore and --lcc need the whole graph and cannot "
+                  "be combined with --stream\n");
+        return;
+      }
+      if (args.count("thresholds")) {
+        log_error("Error: --thresholds writes one file per threshold and "
+                  "cannot be combined with --stream\n");
+        return;
+      }
+      stream_import_string(args, min_score, score_col, delimiter);
+      return;
+    }
     graph =
         tangle::io::load_from_string(infile, min_score, score_col, delimiter);
   } else if (format == "biogrid") {
     log(1, "Importing from BioGRID file '" + infile + "'...\n");
     graph = tangle::io::load_from_biogrid(infile);
+  } else if (format == "mitab") {
+    tangle::io::MitabOptions options;
+    if (args.count("id-db")) {
+      options.id_database = args.at("id-db");
+    }
+    if (args.count("types")) {
+      options.interaction_types = split_list(args.at("types"));
+    }
+    if (args.count("methods")) {
+      options.detection_methods = split_list(args.at("methods"));
+    }
+    if (args.count("taxon")) {
+      options.taxon = args.at("taxon");
+    }
+    if (args.count("score-name")) {
+      options.score_name = args.at("score-name");
+      if (args.count("score")) {
+        options.min_score = std::stod(args.at("score"));
+      }
+    }
+    log(1, "Importing from PSI-MITAB file '" + infile + "' (ids: " +
+               (options.id_database.empty() ? "first listed"
+                                            : options.id_database) +
+               ")...\n");
+    graph = tangle::io::load_from_mitab(infile, options);
   } else {
     log_error("Error: Unknown format '" + format +
-              "'. Supported: string, biogrid\n");
+              "'. Supported: string, biogrid, mitab\n");
     return;
   }
 
   log(1, "  -> Imported " + std::to_string(graph.num_nodes()) + " nodes and " +
              std::to_string(graph.num_edges()) + " edges.\n");
 
+  // STRING lists every pair in both directions and BioGRID/MITAB repeat
+  // pairs once per evidence row; collapse them unless asked not to.
+  if (merge != "none") {
+    log(1, "Collapsing duplicate edges (merge: " + merge + ")...\n");
+    graph = tangle::graph::collapse_multi_edges(graph, edge_merge);
+    log(1, "  -> Kept " + std::to_string(graph.num_edges()) +
+               " unique edges.\n");
+  }
+
+  if (args.count("thresholds")) {
+    if (args.count("kcore") || args.count("lcc")) {
+      log_error("Error: --kcore and --lcc cannot be combined with "
+                "--thresholds\n");
+      return;
+    }
+    tangle::graph::ScoredGraphStore store(graph);
+    for (double t : parse_thresholds(args.at("thresholds"))) {
+      std::string path = threshold_path(outfile, t);
+      log(1, "Saving graph at score >= " + std::to_string(t) + " (" +
+                 std::to_string(store.num_edges(t)) + " edges) to '" + path +
+                 "'...\n");
+      tangle::io::save_edgelist(store.subgraph(t), path,
+                                args.count("weighted") > 0);
+    }
+    log(1, "  -> Done.\n");
+    return;
+  }
+
+  if (args.count("kcore")) {
+    auto k = static_cast<std::uint32_t>(std::stoul(args.at("kcore")));
+    log(1, "Pruning graph to its " + std::to_string(k) + "-core...\n");
+    graph = tangle::algo::k_core(graph, k);
+    log(1, "  -> Kept " + std::to_string(graph.num_nodes()) + " nodes and " +
+               std::to_string(graph.num_edges()) + " edges.\n");
+  }
+
+  if (args.count("lcc")) {
+    log(1, "Extracting the largest connected component...\n");
+    graph = tangle::algo::largest_component(graph);
+    log(1, "  -> Kept " + std::to_string(graph.num_nodes()) + " nodes and " +
+               std::to_string(graph.num_edges()) + " edges.\n");
+  }
+
   log(1, "Saving graph to '" + outfile + "'...\n");
-  tangle::io::save_edgelist(graph, outfile);
+  tangle::io::save_edgelist(graph, outfile, args.count("weighted") > 0);
   log(1, "  -> Done.\n");
 }
 
+// Runs Louvain on a locality-reordered CSR and maps the communities back to
+// the graph's NodeIds.
+std::vector<std::vector<tangle::NodeId>>
+reordered_louvain(const tangle::graph::PpiGraph &graph, const std::string &name,
+                  tangle::algo::NodeOrder order, double resolution) {
+  log(1, "Reordering nodes (" + name + ")...\n");
+  tangle::algo::ReorderedGraph reordered(tangle::graph::CsrGraph(graph), order);
+  auto membership = tangle::algo::louvain_membership(
+      reordered.graph(), false, std::random_device{}(), resolution);
+  return tangle::algo::communities_from_membership(
+      reordered.to_original(membership));
+}
+
 void handle_analyze(const std::map<std::string, std::string> &args) {
   if (args.find("in") == args.end()) {
     log_error("Usage: tangle analyze --in=<edgelist_path> "
-              "[--out=<communities_path>] [--format=tsv|json] [--benchmark]\n");
+              "[--out=<communities_path>] [--format=tsv|json] "
+              "[--consensus=<runs>] [--resolution=<gamma>] "
+              "[--reorder=degree|rcm|rabbit] [--benchmark]\n");
     return;
   }
 
@@ -110,10 +345,46 @@ void handle_analyze(const std::map<std::string, std::string> &args) {
 
   if (!benchmark && args.find("out") == args.end()) {
     log_error("Usage: tangle analyze --in=<edgelist_path> "
-              "--out=<communities_path> [--format=tsv|json]\n");
+              "--out=<communities_path> [--format=tsv|json] "
+              "[--consensus=<runs>] [--resolution=<gamma>] "
+              "[--reorder=degree|rcm|rabbit]\n");
     return;
   }
 
+  // Checked up front so a typo does not surface only after the full load.
+  bool reorder = args.count("reorder") > 0;
+  tangle::algo::NodeOrder order = tangle::algo::NodeOrder::Degree;
+  if (reorder) {
+    try {
+      order = tangle::algo::parse_node_order(args.at("reorder"));
+    } catch (const std::invalid_argument &) {
+      log_error("Error: Unknown node order '" + args.at("reorder") +
+                "'. Supported: degree, rcm, rabbit\n");
+      return;
+    }
+    if (args.count("consensus") && !benchmark) {
+      log_error("Error: --reorder applies to a single Louvain run and cannot "
+                "be combined with --consensus\n");
+      return;
+    }
+  }
+
+  double resolution = 1.0;
+  if (args.count("resolution")) {
+    try {
+      resolution = std::stod(args.at("resolution"));
+    } catch (const std::logic_error &) {
+      log_error("Error: Invalid resolution '" + args.at("resolution") +
+                "'\n");
+      return;
+    }
+    if (args.count("consensus") && !benchmark) {
+      log_error("Error: --resolution applies to a single Louvain run and "
+                "cannot be combined with --consensus\n");
+      return;
+    }
+  }
+
   const std::string &infile = args.at("in");
 
   log(1, "Loading graph from '" + infile + "'...\n");
@@ -126,13 +397,23 @@ void handle_analyze(const std::map<std::string, std::string> &args) {
     log(1, "--- Running Benchmarks ---\n");
 
     auto start_louvain = std::chrono::high_resolution_clock::now();
-    auto communities = tangle::algo::louvain_community(graph);
+    auto communities =
+        reorder ? reordered_louvain(graph, args.at("reorder"), order, resolution)
+                : tangle::algo::louvain_community(graph, false, resolution);
     auto end_louvain = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> louvain_ms =
         end_louvain - start_louvain;
-    log(1, "Louvain community detection: " +
+    log(1, "Louvain community detection (resolution " +
+               std::to_string(resolution) + "): " +
                std::to_string(louvain_ms.count()) + " ms\n");
 
+    tangle::graph::CsrGraph csr(graph);
+    auto quality = tangle::algo::evaluate_partition(
+        csr, tangle::algo::membership_from_communities(communities,
+                                                       graph.num_nodes()));
+    log(1, "  -> Modularity: " + std::to_string(quality.modularity) +
+               ", coverage: " + std::to_string(quality.coverage) + "\n");
+
     auto start_degree = std::chrono::high_resolution_clock::now();
     auto degrees = tangle::algo::degree_centrality(graph);
     auto end_degree = std::chrono::high_resolution_clock::now();
@@ -140,6 +421,13 @@ void handle_analyze(const std::map<std::string, std::string> &args) {
         end_degree - start_degree;
     log(1, "Degree centrality: " + std::to_string(degree_ms.count()) + " ms\n");
 
+    tangle::graph::CompressedCsrGraph compressed(csr);
+    std::size_t csr_bytes = csr.offsets().size() * sizeof(tangle::EdgeId) +
+                            csr.targets().size() * sizeof(tangle::NodeId);
+    log(1, "Compressed adjacency: " + std::to_string(compressed.memory_bytes()) +
+               " bytes (CSR topology: " + std::to_string(csr_bytes) +
+               " bytes)\n");
+
   } else { // tsv
     const std::string &outfile = args.at("out");
     std::string format = "tsv";
@@ -147,14 +435,29 @@ void handle_analyze(const std::map<std::string, std::string> &args) {
       format = args.at("format");
     }
 
-    log(1, "Running Louvain community detection...\n");
-    auto communities = tangle::algo::louvain_community(graph);
+    std::vector<std::vector<tangle::NodeId>> communities;
+    if (args.count("consensus")) {
+      std::size_t runs = std::stoul(args.at("consensus"));
+      log(1, "Running consensus clustering over " + std::to_string(runs) +
+                 " Louvain runs...\n");
+      communities = tangle::algo::consensus_communities(graph, runs);
+    } else {
+      log(1, "Running Louvain community detection (resolution " +
+                 std::to_string(resolution) + ")...\n");
+      communities =
+          reorder ? reordered_louvain(graph, args.at("reorder"), order,
+                                      resolution)
+                  : tangle::algo::louvain_community(graph, false, resolution);
+    }
     log(1,
         "  -> Found " + std::to_string(communities.size()) + " communities.\n");
 
     log(1, "Saving communities to '" + outfile + "' in " + format +
                " format...\n");
-    std::ofstream out_fs(outfile);
+    tangle::io::OutputFile out_fs(outfile);
+    if (!out_fs.is_open()) {
+      throw std::runtime_error("Could not open file for writing: " + outfile);
+    }
 
     if (format == "json") {
 #if TANGLE_WITH_JSON
@@ -173,14 +476,21 @@ void handle_analyze(const std::map<std::string, std::string> &args) {
       return;
 #endif
     } else { // tsv
-      for (const auto &community : communities) {
-        for (size_t i = 0; i < community.size(); ++i) {
-          out_fs << graph.node(community[i]).protein_id
-                 << (i == community.size() - 1 ? "" : "\t");
-        }
-        out_fs << "\n";
-      }
+      const auto &nodes = graph.nodes();
+      tangle::io::write_records(
+          out_fs, communities.size(),
+          [&](std::size_t c, tangle::io::TextBuffer &out) {
+            const auto &community = communities[c];
+            for (size_t i = 0; i < community.size(); ++i) {
+              out << nodes[community[i]].protein_id
+                  << (i == community.size() - 1 ? '\n' : '\t');
+            }
+            if (community.empty()) {
+              out << '\n';
+            }
+          });
     }
+    out_fs.close();
     log(1, "  -> Done.\n");
   }
 }
@@ -189,7 +499,11 @@ void handle_annotate(const std::map<std::string, std::string> &args) {
   if (args.find("in-comm") == args.end() || args.find("in-gaf") == args.end() ||
       args.find("out") == args.end()) {
     log_error("Usage: tangle annotate --in-comm=<communities_path> "
-              "--in-gaf=<gaf_path> --out=<results_path> [--format=tsv|json]\n");
+              "--in-gaf=<gaf_path> --out=<results_path> [--format=tsv|json] "
+              "[--aliases=<protein.aliases.txt> [--alias-source=<s1,s2,...>]] "
+              "[--evidence=<codes>] [--exclude-evidence=<codes>] "
+              "[--aspect=<P|F|C...>] [--taxon=<taxid>] [--skip-not] "
+              "[--save-db=<snapshot_path>]\n");
     return;
   }
 
@@ -205,20 +519,64 @@ void handle_annotate(const std::map<std::string, std::string> &args) {
     p_cutoff = std::stod(args.at("p-cutoff"));
   }
 
-  log(1, "Loading annotations from '" + gaf_file + "'...\n");
+  tangle::annotate::GafFilter filter;
+  if (args.count("evidence")) {
+    filter.evidence_codes = split_list(args.at("evidence"));
+  }
+  if (args.count("exclude-evidence")) {
+    filter.excluded_evidence = split_list(args.at("exclude-evidence"));
+  }
+  if (args.count("aspect")) {
+    filter.aspects = args.at("aspect");
+  }
+  if (args.count("taxon")) {
+    filter.taxon = args.at("taxon");
+  }
+  filter.skip_negated = args.count("skip-not") > 0;
+
+  // --in-gaf also accepts a snapshot written by --save-db; the GAF row
+  // filters were applied when it was saved.
   tangle::annotate::AnnotationDb db;
-  db.load_from_gaf(gaf_file);
-  log(1, "  -> Loaded " + std::to_string(db.get_all_go_terms().size()) +
+  if (tangle::annotate::AnnotationDb::is_binary_snapshot(gaf_file)) {
+    log(1, "Opening annotation snapshot '" + gaf_file + "'...\n");
+    db.open_binary(gaf_file);
+  } else {
+    log(1, "Loading annotations from '" + gaf_file + "'...\n");
+    db.load_from_gaf(gaf_file, filter);
+  }
+  log(1, "  -> Loaded " + std::to_string(db.num_go_terms()) +
              " GO terms for " +
-             std::to_string(db.get_all_annotated_proteins().size()) +
-             " proteins.\n");
+             std::to_string(db.num_annotated_proteins()) + " proteins.\n");
+  if (args.count("save-db")) {
+    log(1, "Saving annotation snapshot to '" + args.at("save-db") + "'...\n");
+    db.save_binary(args.at("save-db"));
+  }
+
+  // STRING ids rarely match GAF accessions; translate each community
+  // member to its first alias from the requested sources.
+  tangle::io::StringAliases aliases;
+  bool translate = args.count("aliases") > 0;
+  if (translate) {
+    std::vector<std::string> sources = {"UniProt_AC"};
+    if (args.count("alias-source")) {
+      sources = split_list(args.at("alias-source"));
+    }
+    log(1, "Loading STRING aliases from '" + args.at("aliases") + "'...\n");
+    aliases = tangle::io::StringAliases(args.at("aliases"), sources);
+    log(1, "  -> Loaded " + std::to_string(aliases.num_pairs()) +
+               " aliases for " + std::to_string(aliases.num_proteins()) +
+               " proteins.\n");
+  }
 
   log(1, "Loading communities from '" + comm_file + "'...\n");
   std::ifstream comm_fs(comm_file);
   std::string line;
   int community_idx = 0;
 
-  std::ofstream out_fs(outfile);
+  tangle::io::OutputFile out_fs(outfile);
+  if (!out_fs.is_open()) {
+    throw std::runtime_error("Could not open file for writing: " + outfile);
+  }
 #if TANGLE_WITH_JSON
   json all_results = json::array();
 #endif
@@ -238,6 +596,11 @@ void handle_annotate(const std::map<std::string, std::string> &args) {
 
     if (community.empty())
       continue;
+    // Translated after the empty check so community numbers stay aligned
+    // with the input lines.
+    if (translate) {
+      community = aliases.to_aliases(community, true);
+    }
 
     log(2, "  -> Analyzing community " + std::to_string(community_idx) +
                " with " + std::to_string(community.size()) + " proteins...\n");
@@ -279,29 +642,299 @@ void handle_annotate(const std::map<std::string, std::string> &args) {
               "-DTANGLE_WITH_JSON=ON\n");
   }
 #endif
+  out_fs.close();
 
   log(1, "Annotation results saved to '" + outfile + "'.\n");
 }
 
 void handle_export(const std::map<std::string, std::string> &args) {
   if (args.find("in") == args.end() || args.find("out") == args.end()) {
-    log_error("Usage: tangle export --in=<edgelist_path> --out=<sbml_path>\n");
+    log_error("Usage: tangle export --in=<edgelist_path> --out=<sbml_path> "
+              "[--level=2|3] [--compress=gzip|zstd]\n");
     return;
   }
 
   const std::string &infile = args.at("in");
   const std::string &outfile = args.at("out");
 
+  // Level 3 is written with the qual package. Compression defaults from
+  // the output extension.
+  tangle::export_::SbmlOptions options;
+  std::string level = args.count("level") ? args.at("level") : "2";
+  if (level == "3") {
+    options.format = tangle::export_::SbmlFormat::Level3Qual;
+  } else if (level != "2") {
+    log_error("Error: Unknown SBML level '" + level + "'. Supported: 2, 3\n");
+    return;
+  }
+  std::string compress;
+  if (args.count("compress")) {
+    compress = args.at("compress");
+  } else if (outfile.size() > 3 &&
+             outfile.compare(outfile.size() - 3, 3, ".gz") == 0) {
+    compress = "gzip";
+  } else if (outfile.size() > 4 &&
+             outfile.compare(outfile.size() - 4, 4, ".zst") == 0) {
+    compress = "zstd";
+  }
+  if (compress == "gzip") {
+    options.compression = tangle::io::Compression::Gzip;
+  } else if (compress == "zstd") {
+    options.compression = tangle::io::Compression::Zstd;
+  } else if (!compress.empty() && compress != "none") {
+    log_error("Error: Unknown compression '" + compress +
+              "'. Supported: gzip, zstd, none\n");
+    return;
+  }
+
+  log(1, "Loading graph from '" + infile + "'...\n");
+  tangle::graph::PpiGraph graph = tangle::io::load_edgelist(infile, false);
+  log(1, "  -> Loaded " + std::to_string(graph.num_nodes()) + " nodes and " +
+             std::to_string(graph.num_edges()) + " edges.\n");
+
+  log(1, "Exporting graph to SBML Level " + level + " at '" + outfile +
+             "'...\n");
+  tangle::export_::save_to_sbml(graph, outfile, options);
+  log(1, "  -> Done.\n");
+}
+
+void handle_randomize(const std::map<std::string, std::string> &args) {
+  if (args.find("in") == args.end() || args.find("out") == args.end()) {
+    log_error("Usage: tangle randomize --in=<edgelist_path> "
+              "--out=<output_prefix> [--count=<n>] [--swaps=<per_edge>] "
+              "[--seed=<seed>]\n");
+    return;
+  }
+
+  const std::string &infile = args.at("in");
+  const std::string &prefix = args.at("out");
+  std::size_t count = 1;
+  if (args.count("count")) {
+    count = std::stoul(args.at("count"));
+  }
+  double swaps = 10.0;
+  if (args.count("swaps")) {
+    swaps = std::stod(args.at("swaps"));
+  }
+  std::uint64_t seed = 0;
+  if (args.count("seed")) {
+    seed = std::stoull(args.at("seed"));
+  }
+
   log(1, "Loading graph from '" + infile + "'...\n");
   tangle::graph::PpiGraph graph = tangle::io::load_edgelist(infile, false);
   log(1, "  -> Loaded " + std::to_string(graph.num_nodes()) + " nodes and " +
              std::to_string(graph.num_edges()) + " edges.\n");
 
-  log(1, "Exporting graph to SBML at '" + outfile + "'...\n");
-  tangle::export_::save_to_sbml(graph, outfile);
+  log(1, "Generating " + std::to_string(count) +
+             " degree-preserving null networks...\n");
+  tangle::algo::generate_null_models(
+      graph, count,
+      [&](std::size_t i, const std::vector<tangle::graph::Edge> &edges) {
+        std::string path = prefix + "_" + std::to_string(i) + ".edgelist";
+        tangle::io::save_edgelist(graph, edges, path);
+        log(2, "  -> Wrote '" + path + "'\n");
+      },
+      swaps, seed);
   log(1, "  -> Done.\n");
 }
 
+// Reads one protein id per line (first whitespace-separated token), skipping
+// empty lines and '#' comments.
+std::vector<tangle::ProteinId> read_id_list(const std::string &filepath) {
+  std::ifstream in(filepath);
+  if (!in.is_open()) {
+    throw std::runtime_error("Could not open id list: " + filepath);
+  }
+  std::vector<tangle::ProteinId> ids;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::stringstream ss(line);
+    std::string id;
+    if (ss >> id && id[0] != '#') {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+
+void handle_proximity(const std::map<std::string, std::string> &args) {
+  if (args.find("in") == args.end() || args.find("targets") == args.end() ||
+      args.find("disease") == args.end()) {
+    log_error("Usage: tangle proximity --in=<edgelist_path> "
+              "--targets=<id_list> --disease=<id_list> [--samples=<n>] "
+              "[--seed=<seed>]\n");
+    return;
+  }
+
+  std::size_t samples = 1000;
+  if (args.count("samples")) {
+    samples = std::stoul(args.at("samples"));
+  }
+  std::uint64_t seed = 0;
+  if (args.count("seed")) {
+    seed = std::stoull(args.at("seed"));
+  }
+
+  const std::string &infile = args.at("in");
+  log(1, "Loading graph from '" + infile + "'...\n");
+  tangle::graph::PpiGraph graph = tangle::io::load_edgelist(infile, false);
+  log(1, "  -> Loaded " + std::to_string(graph.num_nodes()) + " nodes and " +
+             std::to_string(graph.num_edges()) + " edges.\n");
+
+  auto targets = read_id_list(args.at("targets"));
+  auto disease = read_id_list(args.at("disease"));
+
+  log(1, "Computing network proximity with " + std::to_string(samples) +
+             " degree-matched random samples...\n");
+  tangle::algo::NetworkProximity proximity(graph);
+  auto res = proximity.compute(targets, disease, samples, seed);
+  log(1, "  -> Targets in network: " + std::to_string(res.num_targets) + "/" +
+             std::to_string(targets.size()) + ", disease genes in network: " +
+             std::to_string(res.num_disease_genes) + "/" +
+             std::to_string(disease.size()) + "\n");
+  std::cout << "distance\tz_score\trandom_mean\trandom_sd\n"
+            << res.distance << "\t" << res.z_score << "\t" << res.random_mean
+            << "\t" << res.random_sd << "\n";
+}
+
+void handle_knockout(const std::map<std::string, std::string> &args) {
+  if (args.find("in") == args.end() || args.find("out") == args.end()) {
+    log_error("Usage: tangle knockout --in=<edgelist_path> "
+              "--out=<results_path> [--nodes=<id_list>]\n");
+    return;
+  }
+
+  const std::string &infile = args.at("in");
+  log(1, "Loading graph from '" + infile + "'...\n");
+  tangle::graph::PpiGraph graph = tangle::io::load_edgelist(infile, false);
+  log(1, "  -> Loaded " + std::to_string(graph.num_nodes()) + " nodes and " +
+             std::to_string(graph.num_edges()) + " edges.\n");
+
+  std::vector<tangle::NodeId> nodes;
+  if (args.count("nodes")) {
+    for (const auto &pid : read_id_list(args.at("nodes"))) {
+      if (auto id = graph.find_node(pid)) {
+        nodes.push_back(*id);
+      } else {
+        log(1, "  -> Skipping '" + pid + "': not in network.\n");
+      }
+    }
+  } else {
+    for (tangle::NodeId v = 0; v < graph.num_nodes(); ++v) {
+      nodes.push_back(v);
+    }
+  }
+
+  log(1, "Simulating " + std::to_string(nodes.size()) +
+             " single-node knockouts...\n");
+  tangle::graph::CsrGraph csr(graph);
+  auto impact = tangle::algo::knockout_impact(csr, nodes);
+
+  const std::string &outfile = args.at("out");
+  tangle::io::OutputFile out(outfile);
+  if (!out.is_open()) {
+    throw std::runtime_error("Could not open file for writing: " + outfile);
+  }
+  out << "protein\tlargest_component\tnum_components\n";
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    out << graph.node(nodes[i]).protein_id << "\t"
+        << impact[i].largest_component << "\t" << impact[i].num_components
+        << "\n";
+  }
+  out.close();
+  log(1, "  -> Wrote results to '" + outfile + "'\n");
+}
+
+// True if `edge_path` is a complete edge file, no older than `text_path`,
+// whose node table matches it; such a file is reused instead of converting
+// `text_path` again.
+bool up_to_date_edge_file(const std::string &text_path,
+                          const std::string &edge_path) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  if (!tangle::io::is_edge_file(edge_path) ||
+      !fs::exists(edge_path + ".nodes", ec)) {
+    return false;
+  }
+  auto converted = fs::last_write_time(edge_path, ec);
+  if (ec) return false;
+  auto source = fs::last_write_time(text_path, ec);
+  if (ec || converted < source) return false;
+  try {
+    tangle::io::EdgeStream edges(edge_path);
+    return tangle::io::load_node_table(edge_path).size() == edges.num_nodes();
+  } catch (const std::runtime_error &) {
+    return false;
+  }
+}
+
+void handle_stream(const std::map<std::string, std::string> &args) {
+  if (args.find("in") == args.end() || args.find("out") == args.end()) {
+    log_error("Usage: tangle stream --in=<edgelist_or_edge_file> "
+              "--out=<results_path> [--edge-file=<path>] [--overwrite] "
+              "[--passes=<n>]\n");
+    return;
+  }
+
+  const std::string &infile = args.at("in");
+  std::string edge_path = infile;
+  std::vector<tangle::ProteinId> names;
+  if (tangle::io::is_edge_file(infile)) {
+    names = tangle::io::load_node_table(infile);
+  } else {
+    edge_path = args.count("edge-file") ? args.at("edge-file") : infile + ".bin";
+    bool overwrite = args.count("overwrite") > 0;
+    std::error_code ec;
+    if (!overwrite && up_to_date_edge_file(infile, edge_path)) {
+      log(1, "Reusing binary edge file '" + edge_path + "'...\n");
+      names = tangle::io::load_node_table(edge_path);
+    } else if (!overwrite && (std::filesystem::exists(edge_path, ec) ||
+                              std::filesystem::exists(edge_path + ".nodes", ec))) {
+      log_error("Error: '" + edge_path + "' exists but is not an up-to-date " +
+                "edge file for '" + infile + "'. Pass --overwrite to replace " +
+                "it, or choose another --edge-file\n");
+      return;
+    } else {
+      log(1, "Converting '" + infile + "' to binary edge file '" + edge_path +
+                 "'...\n");
+      names = tangle::io::convert_edgelist(infile, edge_path);
+    }
+  }
+
+  tangle::io::EdgeStream edges(edge_path);
+  log(1, "  -> Streaming " + std::to_string(edges.num_edges()) +
+             " edges over " + std::to_string(edges.num_nodes()) + " nodes.\n");
+  if (names.size() != edges.num_nodes()) {
+    throw std::runtime_error("Node table does not match edge file: " +
+                             edge_path);
+  }
+
+  std::size_t passes = 20;
+  if (args.count("passes")) {
+    passes = std::stoul(args.at("passes"));
+  }
+
+  log(1, "Computing degrees, components, label propagation and PageRank...\n");
+  auto degrees = tangle::algo::degree_centrality(edges);
+  auto components = tangle::algo::connected_components(edges);
+  auto labels = tangle::algo::label_propagation(edges, passes);
+  auto rank = tangle::algo::pagerank(edges);
+
+  const std::string &outfile = args.at("out");
+  tangle::io::OutputFile out(outfile);
+  if (!out.is_open()) {
+    throw std::runtime_error("Could not open file for writing: " + outfile);
+  }
+  out << "protein\tdegree\tcomponent\tcommunity\tpagerank\n";
+  for (std::size_t v = 0; v < names.size(); ++v) {
+    out << names[v] << "\t" << degrees[v] << "\t" << components[v] << "\t"
+        << labels[v] << "\t" << rank[v] << "\n";
+  }
+  out.close();
+  log(1, "  -> Wrote results to '" + outfile + "'\n");
+}
+
 // ----------------------------------------------------------------------------
 // Simple command-line parser
 // ----------------------------------------------------------------------------
@@ -311,15 +944,40 @@ void print_usage() {
   log(1, "Subcommands:\n");
   log(1, "  import    Import a PPI network (e.g., from STRING)\n");
   log(1, "            --in=<filepath> --out=<edgelist_path> "
-         "[--score=<min_score>]\n");
+         "[--score=<min_score>] [--merge=max|sum|mean|count|none] "
+         "[--weighted] [--kcore=<k>] [--lcc] "
+         "[--stream [--binary] [--string-symmetric]]\n");
+  log(1, "            [--thresholds=<s1,s2,...>] [--format=string|biogrid|mitab]\n");
+  log(1, "            MITAB: [--id-db=<db>] [--types=<MI ids>] "
+         "[--methods=<MI ids>] [--taxon=<taxid>] [--score-name=<name>]\n");
   log(1, "  analyze   Run network analysis algorithms\n");
   log(1, "            --in=<edgelist_path> --out=<communities_path> "
-         "[--format=tsv|json] [--benchmark]\n");
+         "[--format=tsv|json] [--consensus=<runs>] [--benchmark]\n");
+  log(1, "            [--resolution=<gamma>] [--reorder=degree|rcm|rabbit]\n");
   log(1, "  annotate  Perform functional enrichment\n");
   log(1, "            --in-comm=<communities_path> --in-gaf=<gaf_path> "
          "--out=<results_path> [--format=tsv|json] [--p-cutoff=<p_value>]\n");
+  log(1, "            [--aliases=<protein.aliases.txt> "
+         "[--alias-source=<s1,s2,...>]]\n");
+  log(1, "            [--evidence=<codes>] [--exclude-evidence=<codes>] "
+         "[--aspect=<P|F|C...>] [--taxon=<taxid>] [--skip-not]\n");
+  log(1, "            [--save-db=<snapshot_path>] (--in-gaf also takes a "
+         "snapshot)\n");
   log(1, "  export    Export a network to a file\n");
-  log(1, "            --in=<edgelist_path> --out=<sbml_path>\n");
+  log(1, "            --in=<edgelist_path> --out=<sbml_path> "
+         "[--level=2|3] [--compress=gzip|zstd]\n");
+  log(1, "  randomize Generate degree-preserving null networks\n");
+  log(1, "            --in=<edgelist_path> --out=<output_prefix> "
+         "[--count=<n>] [--swaps=<per_edge>] [--seed=<seed>]\n");
+  log(1, "  proximity Drug-disease network proximity with z-score\n");
+  log(1, "            --in=<edgelist_path> --targets=<id_list> "
+         "--disease=<id_list> [--samples=<n>] [--seed=<seed>]\n");
+  log(1, "  knockout  Component impact of single-node knockouts\n");
+  log(1, "            --in=<edgelist_path> --out=<results_path> "
+         "[--nodes=<id_list>]\n");
+  log(1, "  stream    Out-of-core degree/components/communities/PageRank\n");
+  log(1, "            --in=<edgelist_or_edge_file> --out=<results_path> "
+         "[--edge-file=<path>] [--overwrite] [--passes=<n>]\n");
 }
 
 int main(int argc, char *argv[]) {
@@ -351,6 +1009,8 @@ int main(int argc, char *argv[]) {
       size_t eq_pos = arg.find('=');
       if (eq_pos != std::string::npos) {
         args[arg.substr(2, eq_pos - 2)] = arg.substr(eq_pos + 1);
+      } else {
+        args[arg.substr(2)] = "true"; // Boolean flag, e.g. --lcc
       }
     } else {
       positional_args.push_back(arg);
@@ -369,7 +1029,11 @@ int main(int argc, char *argv[]) {
       handlers = {{"import", handle_import},
                   {"analyze", handle_analyze},
                   {"annotate", handle_annotate},
-                  {"export", handle_export}};
+                  {"export", handle_export},
+                  {"randomize", handle_randomize},
+                  {"proximity", handle_proximity},
+                  {"knockout", handle_knockout},
+                  {"stream", handle_stream}};
 
   if (handlers.find(subcommand) == handlers.end()) {
     log_error("Error: Unknown subcommand '" + subcommand + "'\n");
@@ -0,0 +1,160 @@
+#include "tangle/perfect_hash.hpp"
+#include "tangle/parallel.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace tangle {
+
+namespace {
+
+// splitmix64 finalizer.
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+void prefetch(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+} // namespace
+
+std::uint64_t PerfectHash::hash(std::string_view key) {
+    const char* p = key.data();
+    std::size_t len = key.size();
+    std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ (len * 0xff51afd7ed558ccdULL);
+    while (len >= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p, 8);
+        h = mix(h ^ word);
+        p += 8;
+        len -= 8;
+    }
+    if (len > 0) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, p, len);
+        h = mix(h ^ word ^ 0x5851f42d4c957f2dULL);
+    }
+    return h;
+}
+
+std::size_t PerfectHash::slot(std::uint64_t h, std::int32_t pilot) const {
+    if (pilot < 0) return static_cast<std::size_t>(-(pilot + 1));
+    return mix(h ^ (static_cast<std::uint64_t>(pilot) * 0x9e3779b97f4a7c15ULL)) % index_.size();
+}
+
+PerfectHash::PerfectHash(const std::vector<std::string_view>& keys) {
+    if (keys.empty()) return;
+    if (keys.size() > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+        throw std::length_error("Too many keys for PerfectHash");
+    }
+    // 32-bit, so the compiler can see the bound on every allocation below.
+    const std::uint32_t n = static_cast<std::uint32_t>(keys.size());
+
+    std::vector<std::uint64_t> hashes(n);
+    parallel::parallel_for(0, n, [&](std::size_t i) { hashes[i] = hash(keys[i]); }, 4096);
+
+    // Group keys into one bucket per key on average.
+    const std::uint32_t nb = n;
+    pilots_.assign(nb, 0);
+    index_.assign(n, 0);
+    std::vector<std::uint32_t> start(nb + 1, 0);
+    for (std::uint64_t h : hashes) start[h % nb + 1]++;
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<std::uint32_t> members(n);
+    {
+        std::vector<std::uint32_t> cursor(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < n; ++i) members[cursor[hashes[i] % nb]++] = static_cast<std::uint32_t>(i);
+    }
+    auto bucket_size = [&](std::size_t b) { return start[b + 1] - start[b]; };
+
+    // Place the largest buckets first, while most slots are still free.
+    std::vector<std::uint32_t> order(nb);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::uint32_t a, std::uint32_t b) { return bucket_size(a) > bucket_size(b); });
+
+    std::vector<char> taken(n, 0);
+    std::vector<std::size_t> slots;
+    std::size_t k = 0;
+    for (; k < nb && bucket_size(order[k]) >= 2; ++k) {
+        const std::uint32_t b = order[k];
+        const std::uint32_t* first = members.data() + start[b];
+        const std::uint32_t* last = members.data() + start[b + 1];
+        // Equal hashes can never be separated by a pilot.
+        for (const std::uint32_t* i = first; i != last; ++i) {
+            for (const std::uint32_t* j = i + 1; j != last; ++j) {
+                if (hashes[*i] == hashes[*j]) {
+                    throw std::invalid_argument("Duplicate key in PerfectHash: " + std::string(keys[*i]));
+                }
+            }
+        }
+        for (std::int32_t pilot = 0;; ++pilot) {
+            slots.clear();
+            bool ok = true;
+            for (const std::uint32_t* i = first; i != last && ok; ++i) {
+                std::size_t s = slot(hashes[*i], pilot);
+                ok = !taken[s] && std::find(slots.begin(), slots.end(), s) == slots.end();
+                slots.push_back(s);
+            }
+            if (!ok) continue;
+            for (std::size_t j = 0; j < slots.size(); ++j) {
+                taken[slots[j]] = 1;
+                index_[slots[j]] = first[j];
+            }
+            pilots_[b] = pilot;
+            break;
+        }
+    }
+
+    // Single-key buckets take the remaining free slots directly.
+    std::size_t free_slot = 0;
+    for (; k < nb && bucket_size(order[k]) == 1; ++k) {
+        while (taken[free_slot]) ++free_slot;
+        taken[free_slot] = 1;
+        index_[free_slot] = members[start[order[k]]];
+        pilots_[order[k]] = -static_cast<std::int32_t>(free_slot) - 1;
+    }
+}
+
+std::size_t PerfectHash::find(std::string_view key) const {
+    if (index_.empty()) return npos;
+    std::uint64_t h = hash(key);
+    return index_[slot(h, pilots_[h % num_buckets()])];
+}
+
+void PerfectHash::find_many(const std::string_view* keys, std::size_t count, std::size_t* out) const {
+    if (index_.empty()) {
+        std::fill(out, out + count, npos);
+        return;
+    }
+    constexpr std::size_t kBatch = 16;
+    std::uint64_t h[kBatch];
+    std::size_t s[kBatch];
+    for (std::size_t base = 0; base < count; base += kBatch) {
+        const std::size_t m = std::min(kBatch, count - base);
+        for (std::size_t i = 0; i < m; ++i) {
+            h[i] = hash(keys[base + i]);
+            prefetch(&pilots_[h[i] % num_buckets()]);
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            s[i] = slot(h[i], pilots_[h[i] % num_buckets()]);
+            prefetch(&index_[s[i]]);
+        }
+        for (std::size_t i = 0; i < m; ++i) out[base + i] = index_[s[i]];
+    }
+}
+
+} // namespace tangle
@@ -0,0 +1,85 @@
+#include "tangle/scored_graph.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace tangle {
+namespace graph {
+
+ScoredGraphStore::ScoredGraphStore(const PpiGraph& graph, unsigned int threads)
+    : nodes_(graph.nodes()),
+      edges_(canonicalize_edges(graph.edges(), EdgeMerge::Max, threads)) {
+    // Canonical edges are sorted by (u, v); a stable sort keeps that order
+    // among equal scores.
+    std::stable_sort(edges_.begin(), edges_.end(),
+                     [](const Edge& a, const Edge& b) { return a.weight > b.weight; });
+
+    // Scatter in descending score order, so every row comes out score-sorted.
+    const std::size_t n = nodes_.size();
+    offsets_.assign(n + 1, 0);
+    for (const auto& e : edges_) {
+        offsets_[e.u + 1]++;
+        offsets_[e.v + 1]++;
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    std::vector<EdgeId> cursor(offsets_.begin(), offsets_.end() - 1);
+    targets_.resize(offsets_.back());
+    scores_.resize(offsets_.back());
+    for (const auto& e : edges_) {
+        EdgeId i = cursor[e.u]++;
+        targets_[i] = e.v;
+        scores_[i] = e.weight;
+        EdgeId j = cursor[e.v]++;
+        targets_[j] = e.u;
+        scores_[j] = e.weight;
+    }
+}
+
+std::size_t ScoredGraphStore::cutoff(const Weight* first, const Weight* last, double min_score) {
+    return static_cast<std::size_t>(
+        std::partition_point(first, last, [&](Weight w) { return w >= min_score; }) - first);
+}
+
+Range<Edge> ScoredGraphStore::edges(double min_score) const {
+    auto last = std::partition_point(edges_.begin(), edges_.end(),
+                                     [&](const Edge& e) { return e.weight >= min_score; });
+    return {edges_.data(), edges_.data() + (last - edges_.begin())};
+}
+
+NeighborRange ScoredGraphStore::neighbors(NodeId v, double min_score) const {
+    if (v >= num_nodes()) {
+        throw std::out_of_range("NodeId out of range in ScoredGraphStore::neighbors");
+    }
+    const Weight* first = scores_.data() + offsets_[v];
+    std::size_t len = cutoff(first, scores_.data() + offsets_[v + 1], min_score);
+    return {targets_.data() + offsets_[v], targets_.data() + offsets_[v] + len};
+}
+
+WeightRange ScoredGraphStore::neighbor_scores(NodeId v, double min_score) const {
+    if (v >= num_nodes()) {
+        throw std::out_of_range("NodeId out of range in ScoredGraphStore::neighbor_scores");
+    }
+    const Weight* first = scores_.data() + offsets_[v];
+    return {first, first + cutoff(first, scores_.data() + offsets_[v + 1], min_score)};
+}
+
+const CsrGraph& ScoredGraphStore::csr(double min_score) const {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto& slot = csr_cache_[min_score];
+    if (!slot) {
+        Range<Edge> prefix = edges(min_score);
+        slot = std::make_unique<CsrGraph>(num_nodes(),
+                                          std::vector<Edge>(prefix.begin(), prefix.end()));
+    }
+    return *slot;
+}
+
+PpiGraph ScoredGraphStore::subgraph(double min_score) const {
+    PpiGraph sub;
+    for (const auto& n : nodes_) sub.add_node(n.protein_id, n.gene_symbol);
+    for (const auto& e : edges(min_score)) sub.add_edge(e.u, e.v, e.weight);
+    return sub;
+}
+
+} // namespace graph
+} // namespace tangle
@@ -229,13 +229,17 @@ struct AppState {
     preview_file(path);
     try {
       auto temp_db = std::make_shared<tangle::annotate::AnnotationDb>();
-      temp_db->load_from_gaf(path);
+      if (tangle::annotate::AnnotationDb::is_binary_snapshot(path)) {
+        temp_db->open_binary(path);
+      } else {
+        temp_db->load_from_gaf(path);
+      }
       std::lock_guard<std::mutex> lock(mtx);
       annotation_db = temp_db;
       status_message = "GAF Loaded.";
       is_loading = false;
       logs.push_front("Annotations loaded. Found " +
-                      std::to_string(annotation_db->get_all_go_terms().size()) +
+                      std::to_string(annotation_db->num_go_terms()) +
                       " GO terms.");
     } catch (const std::exception &e) {
       log("Error loading GAF file: " + std::string(e.what()));
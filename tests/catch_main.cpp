@@ -2,20 +2,47 @@
 #include "catch.hpp"
 #include "tangle/algo/centrality.hpp"
 #include "tangle/algo/community.hpp"
+#include "tangle/algo/components.hpp"
+#include "tangle/algo/kcore.hpp"
+#include "tangle/algo/metrics.hpp"
+#include "tangle/algo/null_model.hpp"
+#include "tangle/algo/proximity.hpp"
+#include "tangle/algo/quality.hpp"
+#include "tangle/algo/reorder.hpp"
+#include "tangle/algo/streaming.hpp"
+#include "tangle/algo/traversal.hpp"
+#include "tangle/algo/weighted_paths.hpp"
+#include "tangle/compressed_graph.hpp"
+#include "tangle/csr_graph.hpp"
+#include "tangle/graph_overlay.hpp"
+#include "tangle/perfect_hash.hpp"
 #include "tangle/annotate/annotation_db.hpp"
 #include "tangle/annotate/go_enrichment.hpp"
 #include "tangle/export/sbml_exporter.hpp"
 #include "tangle/graph.hpp"
+#include "tangle/io/edge_file.hpp"
 #include "tangle/io/edgelist_io.hpp"
+#include "tangle/io/input_file.hpp"
+#include "tangle/io/mitab_importer.hpp"
+#include "tangle/io/output_file.hpp"
+#include "tangle/io/string_aliases.hpp"
 #include "tangle/io/string_importer.hpp"
+#include "tangle/scored_graph.hpp"
 #include <algorithm> // For std::sort
+#include <cmath>     // For std::exp
 #include <cstdio>    // For std::remove
+#include <cstring>
 #include <ctime>     // For std::time
 #include <fstream>
 #include <numeric>   // For std::iota, etc.
+#include <random>
+#include <sstream>
 #include <streambuf> // For std::istreambuf_iterator
 #include <string>
 #include <vector> // For std::vector comparison
+#ifdef TANGLE_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 // Helper to create a temporary edgelist file (already present, just for
 // context)
@@ -47,6 +74,108 @@ TEST_CASE("PpiGraph core functionality", "[graph]") {
   REQUIRE(g.node(b).protein_id == "Q99999");
 }
 
+TEST_CASE("Edge canonicalization and multi-edge collapsing", "[graph]") {
+  using tangle::graph::EdgeMerge;
+  std::vector<tangle::graph::Edge> rows = {
+      {1, 0, 700.0}, {0, 1, 900.0}, {2, 2, 1.0}, {2, 1, 3.0}, {1, 2, 5.0},
+      {1, 2, 1.0},   {3, 0, 2.0}};
+
+  auto max_edges = tangle::graph::canonicalize_edges(rows, EdgeMerge::Max);
+  REQUIRE(max_edges.size() == 3);
+  REQUIRE(max_edges[0].u == 0);
+  REQUIRE(max_edges[0].v == 1);
+  REQUIRE(max_edges[0].weight == 900.0);
+  REQUIRE(max_edges[1].u == 0);
+  REQUIRE(max_edges[1].v == 3);
+  REQUIRE(max_edges[2].u == 1);
+  REQUIRE(max_edges[2].v == 2);
+  REQUIRE(max_edges[2].weight == 5.0);
+
+  REQUIRE(tangle::graph::canonicalize_edges(rows, EdgeMerge::Sum)[2].weight ==
+          9.0);
+  REQUIRE(tangle::graph::canonicalize_edges(rows, EdgeMerge::Mean)[2].weight ==
+          3.0);
+  REQUIRE(tangle::graph::canonicalize_edges(rows, EdgeMerge::Count)[0].weight ==
+          2.0);
+  REQUIRE(tangle::graph::parse_edge_merge("count") == EdgeMerge::Count);
+  REQUIRE_THROWS_AS(tangle::graph::parse_edge_merge("median"),
+                    std::invalid_argument);
+
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i < 4; ++i) {
+    g.get_or_add_node("P" + std::to_string(i));
+  }
+  for (const auto &e : rows) {
+    g.add_edge(e.u, e.v, e.weight);
+  }
+  auto collapsed = tangle::graph::collapse_multi_edges(g);
+  REQUIRE(collapsed.num_nodes() == 4);
+  REQUIRE(collapsed.num_edges() == 3);
+  REQUIRE(collapsed.neighbors(1).size() == 2);
+  REQUIRE(collapsed.node(3).protein_id == "P3");
+
+  SECTION("Large shuffled input takes the parallel radix path") {
+    const tangle::NodeId n = 5000;
+    std::vector<tangle::graph::Edge> big;
+    for (tangle::NodeId i = 0; i < n; ++i) {
+      for (tangle::NodeId k = 1; k <= 20; ++k) {
+        tangle::NodeId j = (i * 7919 + k * 104729) % n;
+        big.push_back({i, j, 1.0});
+        big.push_back({j, i, 1.0});
+      }
+    }
+    auto canon = tangle::graph::canonicalize_edges(big, EdgeMerge::Count, 4);
+    tangle::graph::CsrGraph csr(n, big);
+    REQUIRE(canon.size() == csr.num_edges());
+    bool sorted = true;
+    for (std::size_t i = 1; i < canon.size(); ++i) {
+      sorted = sorted && (canon[i - 1].u < canon[i].u ||
+                          (canon[i - 1].u == canon[i].u &&
+                           canon[i - 1].v < canon[i].v));
+    }
+    REQUIRE(sorted);
+  }
+}
+
+TEST_CASE("Score-indexed multi-threshold graph store", "[graph][scored]") {
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i < 5; ++i) {
+    g.get_or_add_node("P" + std::to_string(i));
+  }
+  g.add_edge(0, 1, 950.0);
+  g.add_edge(1, 0, 950.0); // STRING's reverse row
+  g.add_edge(0, 2, 720.0);
+  g.add_edge(0, 3, 450.0);
+  g.add_edge(2, 3, 910.0);
+  g.add_edge(3, 4, 300.0);
+
+  tangle::graph::ScoredGraphStore store(g);
+  REQUIRE(store.num_nodes() == 5);
+  REQUIRE(store.num_edges(0.0) == 5);
+  REQUIRE(store.num_edges(400.0) == 4);
+  REQUIRE(store.num_edges(700.0) == 3);
+  REQUIRE(store.num_edges(900.0) == 2);
+  REQUIRE(store.num_edges(1000.0) == 0);
+  REQUIRE(store.edges(900.0)[0].weight == 950.0);
+
+  auto nbrs = store.neighbors(0, 700.0);
+  REQUIRE(std::vector<tangle::NodeId>(nbrs.begin(), nbrs.end()) ==
+          std::vector<tangle::NodeId>{1, 2});
+  REQUIRE(store.neighbor_scores(0, 0.0).size() == 3);
+  REQUIRE(store.neighbor_scores(0, 0.0)[2] == 450.0);
+  REQUIRE(store.neighbors(4, 400.0).empty());
+
+  const auto &csr700 = store.csr(700.0);
+  REQUIRE(csr700.num_edges() == 3);
+  REQUIRE(csr700.degree(0) == 2);
+  REQUIRE(&store.csr(700.0) == &csr700); // cached
+
+  auto sub = store.subgraph(900.0);
+  REQUIRE(sub.num_nodes() == 5);
+  REQUIRE(sub.num_edges() == 2);
+  REQUIRE(sub.node(4).protein_id == "P4");
+}
+
 TEST_CASE("Edgelist I/O functionality", "[io]") {
   // Test unweighted edgelist load
   std::string unweighted_content = "ProtA\tProtB\nProtB\tProtC\nProtC\tProtA\n";
@@ -100,6 +229,163 @@ TEST_CASE("Edgelist I/O functionality", "[io]") {
   std::remove(save_filepath.c_str()); // Clean up temp file
 }
 
+TEST_CASE("Buffered output writers", "[io][output]") {
+  // Numbers format as a default std::ostream would.
+  std::vector<double> values = {0.0,  1.0,     0.5,  1e-5,  123456789.0,
+                                -2.5, 1.0 / 3, 1e300, 0.001, 7e-310};
+  tangle::io::TextBuffer text;
+  std::ostringstream expected;
+  for (double v : values) {
+    text << v << '\t';
+    expected << v << '\t';
+  }
+  text << 42 << ' ' << std::size_t{18446744073709551615ULL} << ' ' << -7L
+       << " end\n";
+  expected << 42 << ' ' << std::size_t{18446744073709551615ULL} << ' ' << -7L
+           << " end\n";
+  REQUIRE(text.view() == expected.str());
+
+  // Parallel chunked formatting matches a serial loop byte for byte.
+  std::string path = create_temp_edgelist_file("", "output_file_");
+  auto format = [](std::size_t i, tangle::io::TextBuffer &out) {
+    out << "row" << i << '\t' << static_cast<double>(i) / 7 << '\n';
+  };
+  std::string serial;
+  {
+    tangle::io::TextBuffer all;
+    for (std::size_t i = 0; i < 10000; ++i) {
+      format(i, all);
+    }
+    serial = std::string("header\n") + std::string(all.view());
+  }
+  for (unsigned int threads : {1u, 4u}) {
+    tangle::io::OutputFile out(path, 64);
+    REQUIRE(out.is_open());
+    out << "header\n";
+    tangle::io::write_records(out, 10000, format, threads, 333);
+    out.close();
+    std::ifstream in(path, std::ios::binary);
+    std::string written((std::istreambuf_iterator<char>(in)),
+                        std::istreambuf_iterator<char>());
+    REQUIRE(written == serial);
+  }
+
+#ifdef TANGLE_HAVE_ZLIB
+  // Compressed chunks are separate gzip members of one stream.
+  {
+    tangle::io::OutputFile out(path, 64, tangle::io::Compression::Gzip);
+    out << "header\n";
+    tangle::io::write_records(out, 10000, format, 4, 333);
+    out.close();
+    tangle::io::InputFile in(path);
+    std::string written((std::istreambuf_iterator<char>(in)),
+                        std::istreambuf_iterator<char>());
+    REQUIRE(written == serial);
+  }
+#endif
+
+  // save_edgelist keeps edge order and weights.
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i < 3; ++i) {
+    g.add_node("P" + std::to_string(i));
+  }
+  std::vector<tangle::graph::Edge> edges = {{2, 0, 0.25}, {0, 1, 900}};
+  tangle::io::save_edgelist(g, edges, path, true);
+  std::ifstream in(path);
+  std::string written((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+  REQUIRE(written == "P2\tP0\t0.25\nP0\tP1\t900\n");
+  edges.push_back({0, 3, 1.0});
+  REQUIRE_THROWS_AS(tangle::io::save_edgelist(g, edges, path),
+                    std::out_of_range);
+
+  REQUIRE_FALSE(tangle::io::OutputFile("/nonexistent_dir/out.tsv").is_open());
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Compressed importer input", "[io][compressed]") {
+  using tangle::io::Compression;
+  std::string content;
+  for (int i = 0; i < 2000; ++i) {
+    content += "P" + std::to_string(i % 300) + "\tP" + std::to_string((i * 7 + 1) % 300) + "\n";
+  }
+  std::string plain = create_temp_edgelist_file(content, "test_plain_input_");
+  REQUIRE(tangle::io::detect_compression(plain) == Compression::None);
+  REQUIRE(tangle::io::compression_supported(Compression::None));
+  tangle::graph::PpiGraph expected = tangle::io::load_edgelist(plain);
+
+  {
+    tangle::io::InputFile missing("no_such_input_file.txt");
+    REQUIRE_FALSE(missing.is_open());
+  }
+
+#ifdef TANGLE_HAVE_ZLIB
+  // Two gzip members back to back, as written by bgzip or `cat a.gz b.gz`.
+  std::string gz = plain + ".gz";
+  const std::size_t half = content.size() / 2;
+  for (int member = 0; member < 2; ++member) {
+    gzFile f = gzopen(gz.c_str(), member == 0 ? "wb" : "ab");
+    REQUIRE(f != nullptr);
+    std::string part = member == 0 ? content.substr(0, half) : content.substr(half);
+    gzwrite(f, part.data(), static_cast<unsigned>(part.size()));
+    gzclose(f);
+  }
+  REQUIRE(tangle::io::detect_compression(gz) == Compression::Gzip);
+
+  SECTION("Small ring chunks reproduce the text exactly") {
+    tangle::io::InputFile in(gz, 64, 3);
+    REQUIRE(in.is_open());
+    REQUIRE(in.compression() == Compression::Gzip);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    REQUIRE(text == content);
+  }
+
+  SECTION("Importers read gzip transparently") {
+    tangle::graph::PpiGraph g = tangle::io::load_edgelist(gz);
+    REQUIRE(g.num_nodes() == expected.num_nodes());
+    REQUIRE(g.num_edges() == expected.num_edges());
+
+    std::string string_gz = plain + ".string.gz";
+    gzFile f = gzopen(string_gz.c_str(), "wb");
+    std::string rows = "protein1 protein2 combined_score\n9606.A 9606.B 900\n9606.B 9606.C 400\n";
+    gzwrite(f, rows.data(), static_cast<unsigned>(rows.size()));
+    gzclose(f);
+    auto sg = tangle::io::load_from_string(string_gz, 700.0, 3);
+    REQUIRE(sg.num_edges() == 1);
+    std::remove(string_gz.c_str());
+
+    std::string gaf_gz = plain + ".gaf.gz";
+    f = gzopen(gaf_gz.c_str(), "wb");
+    std::string gaf = "!gaf-version: 2.2\nUniProtKB\tP1\tSYM1\t\tGO:0000001\tPMID:1\n";
+    gzwrite(f, gaf.data(), static_cast<unsigned>(gaf.size()));
+    gzclose(f);
+    tangle::annotate::AnnotationDb db;
+    db.load_from_gaf(gaf_gz);
+    REQUIRE(db.get_annotations("P1") == std::vector<std::string>{"GO:0000001"});
+    std::remove(gaf_gz.c_str());
+  }
+
+  SECTION("Truncated gzip data is an error, not a short read") {
+    std::ifstream in(gz, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::string cut = plain + ".cut.gz";
+    std::ofstream(cut, std::ios::binary) << bytes.substr(0, bytes.size() / 4);
+    REQUIRE_THROWS_AS(tangle::io::load_edgelist(cut), std::runtime_error);
+    std::remove(cut.c_str());
+  }
+  std::remove(gz.c_str());
+#endif
+
+#ifndef TANGLE_HAVE_ZSTD
+  std::string zst = plain + ".zst";
+  std::ofstream(zst, std::ios::binary) << "\x28\xb5\x2f\xfd" << "payload";
+  REQUIRE(tangle::io::detect_compression(zst) == Compression::Zstd);
+  REQUIRE_THROWS_AS(tangle::io::load_edgelist(zst), std::runtime_error);
+  std::remove(zst.c_str());
+#endif
+  std::remove(plain.c_str());
+}
+
 TEST_CASE("Degree Centrality algorithm", "[algo][centrality]") {
   SECTION("Unweighted graph") {
     // Create a simple graph: A-B, B-C, C-D
@@ -205,6 +491,841 @@ TEST_CASE("Louvain Community Detection algorithm", "[algo][community]") {
   REQUIRE((case1 || case2));
 }
 
+TEST_CASE("K-core decomposition", "[algo][kcore]") {
+  // A 4-clique (core 3) with a tail 3-4-5 (core 1) and an isolated node 6.
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i <= 6; ++i) {
+    g.get_or_add_node(std::to_string(i));
+  }
+  g.add_edge(0, 1);
+  g.add_edge(0, 2);
+  g.add_edge(0, 3);
+  g.add_edge(1, 2);
+  g.add_edge(1, 3);
+  g.add_edge(2, 3);
+  g.add_edge(3, 4);
+  g.add_edge(4, 5);
+
+  std::vector<std::uint32_t> expected = {3, 3, 3, 3, 1, 1, 0};
+
+  SECTION("Bucket algorithm") {
+    REQUIRE(tangle::algo::core_numbers(g) == expected);
+  }
+
+  SECTION("Parallel peeling matches bucket algorithm") {
+    REQUIRE(tangle::algo::core_numbers_parallel(g, 4) == expected);
+  }
+
+  SECTION("K-core subgraph") {
+    tangle::graph::PpiGraph core = tangle::algo::k_core(g, 3);
+    REQUIRE(core.num_nodes() == 4);
+    REQUIRE(core.num_edges() == 6);
+    REQUIRE(core.find_node("3").has_value());
+    REQUIRE_FALSE(core.find_node("4").has_value());
+  }
+}
+
+TEST_CASE("Connected components", "[algo][components]") {
+  // Components: {0,1,2,5}, {3,4}, {6}
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i <= 6; ++i) {
+    g.get_or_add_node(std::to_string(i));
+  }
+  g.add_edge(5, 2);
+  g.add_edge(0, 1);
+  g.add_edge(4, 3);
+  g.add_edge(1, 2);
+
+  auto labels = tangle::algo::connected_components(g, 4);
+  REQUIRE(labels == std::vector<tangle::NodeId>{0, 0, 0, 1, 1, 0, 2});
+  REQUIRE(tangle::algo::component_sizes(labels) ==
+          std::vector<std::size_t>{4, 2, 1});
+
+  auto lcc = tangle::algo::largest_component(g);
+  REQUIRE(lcc.num_nodes() == 4);
+  REQUIRE(lcc.num_edges() == 3);
+  REQUIRE(lcc.find_node("5").has_value());
+  REQUIRE_FALSE(lcc.find_node("3").has_value());
+
+  SECTION("Long chain processed in parallel") {
+    tangle::graph::PpiGraph chain;
+    const int n = 20000;
+    for (int i = 0; i < n; ++i) {
+      chain.get_or_add_node(std::to_string(i));
+    }
+    for (int i = n - 1; i > 0; --i) {
+      chain.add_edge(i, i - 1);
+    }
+    auto chain_labels = tangle::algo::connected_components(chain, 8);
+    REQUIRE(std::all_of(chain_labels.begin(), chain_labels.end(),
+                        [](tangle::NodeId c) { return c == 0; }));
+  }
+}
+
+TEST_CASE("Compressed CSR adjacency", "[graph][compressed]") {
+  // Two hubs with rows longer than several index blocks, a sparse ring
+  // and a second component.
+  const tangle::NodeId n = 3000;
+  std::vector<tangle::graph::Edge> edges;
+  for (tangle::NodeId v = 2; v < 2000; ++v) {
+    edges.push_back({v, v + 1 < 2000 ? v + 1 : 2, 1.0});
+    if (v % 3 == 0) edges.push_back({0, v, 1.0});
+    if (v % 5 == 0) edges.push_back({v, 1, 1.0});
+  }
+  for (tangle::NodeId v = 2000; v + 1 < n; ++v) {
+    edges.push_back({v + 1, v, 1.0});
+  }
+  edges.push_back({0, 3, 1.0}); // duplicate
+  edges.push_back({7, 7, 1.0}); // self-loop
+
+  tangle::graph::CsrGraph csr(n, edges);
+  tangle::graph::CompressedCsrGraph compressed(csr);
+  tangle::graph::CompressedCsrGraph direct(n, edges);
+  REQUIRE(compressed.num_nodes() == n);
+  REQUIRE(compressed.num_edges() == csr.num_edges());
+  REQUIRE(direct.num_edges() == csr.num_edges());
+  REQUIRE(compressed.degree(0) > 3 * tangle::graph::CompressedCsrGraph::kBlockSize);
+
+  bool rows_match = true, random_access = true, lookups = true;
+  for (tangle::NodeId v = 0; v < n; ++v) {
+    auto expected = csr.neighbors(v);
+    std::vector<tangle::NodeId> decoded(compressed.neighbors(v).begin(),
+                                        compressed.neighbors(v).end());
+    std::vector<tangle::NodeId> decoded_direct;
+    for (tangle::NodeId u : direct.neighbors(v)) decoded_direct.push_back(u);
+    rows_match = rows_match &&
+                 decoded == std::vector<tangle::NodeId>(expected.begin(), expected.end()) &&
+                 decoded_direct == decoded && compressed.degree(v) == csr.degree(v);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      random_access = random_access && compressed.neighbor(v, i) == expected[i];
+      lookups = lookups && compressed.has_edge(v, expected[i]);
+      if (expected[i] + 1 < n) {
+        lookups = lookups && compressed.has_edge(v, expected[i] + 1) ==
+                                 std::binary_search(expected.begin(), expected.end(),
+                                                    expected[i] + 1);
+      }
+    }
+  }
+  REQUIRE(rows_match);
+  REQUIRE(random_access);
+  REQUIRE(lookups);
+  REQUIRE_FALSE(compressed.has_edge(0, 1));
+  REQUIRE_THROWS_AS(compressed.neighbor(2, 10), std::out_of_range);
+
+  REQUIRE(tangle::algo::distances_from(compressed, 5, 4) ==
+          tangle::algo::distances_from(csr, 5, 4));
+  REQUIRE(tangle::algo::connected_components(compressed, 4) ==
+          tangle::algo::connected_components(n, edges, 4));
+
+  std::size_t csr_bytes = csr.offsets().size() * sizeof(tangle::EdgeId) +
+                          csr.targets().size() * sizeof(tangle::NodeId);
+  REQUIRE(compressed.memory_bytes() < csr_bytes);
+
+  SECTION("Built from a binary edge file in bounded node ranges") {
+    const std::string path = "test_compressed_edges.bin";
+    {
+      tangle::io::EdgeFileWriter writer(path, 100);
+      for (const auto &e : edges) writer.add_edge(e.u, e.v);
+      writer.finish(n);
+    }
+    tangle::io::EdgeStream stream(path, 64);
+    // A 500-entry buffer splits the rows into many ranges; hub 0 alone
+    // exceeds it and gets a range of its own.
+    for (std::size_t buffer : {std::size_t{500}, std::size_t{1} << 25}) {
+      tangle::graph::CompressedCsrGraph streamed(stream, buffer);
+      REQUIRE(streamed.num_nodes() == n);
+      REQUIRE(streamed.num_edges() == csr.num_edges());
+      REQUIRE(streamed.memory_bytes() == compressed.memory_bytes());
+      bool same = true;
+      for (tangle::NodeId v = 0; v < n; ++v) {
+        same = same && std::equal(streamed.neighbors(v).begin(), streamed.neighbors(v).end(),
+                                  compressed.neighbors(v).begin()) &&
+               streamed.degree(v) == compressed.degree(v);
+      }
+      REQUIRE(same);
+      REQUIRE(streamed.neighbor(0, 200) == compressed.neighbor(0, 200));
+    }
+    std::remove(path.c_str());
+  }
+}
+
+TEST_CASE("Graph overlay and knockout simulation", "[graph][components]") {
+  // Path 0-1-2-3 plus a triangle 3-4-5; node 2 is a cut vertex.
+  tangle::graph::CsrGraph base(
+      6, {{0, 1, 1.0}, {1, 2, 1.0}, {2, 3, 1.0}, {3, 4, 1.0}, {4, 5, 1.0},
+          {5, 3, 1.0}});
+  tangle::graph::GraphOverlay overlay(base);
+  REQUIRE(overlay.empty());
+  REQUIRE(overlay.degree(3) == 3);
+
+  overlay.remove_node(2);
+  REQUIRE(overlay.is_removed(2));
+  REQUIRE(overlay.degree(1) == 1);
+  REQUIRE(overlay.degree(3) == 2);
+  REQUIRE_FALSE(overlay.has_edge(1, 2));
+  REQUIRE(tangle::algo::connected_components(overlay) ==
+          std::vector<tangle::NodeId>{0, 0, 1, 2, 2, 2});
+  REQUIRE(tangle::algo::distances_from(overlay, 0)[3] ==
+          tangle::algo::kUnreachable);
+
+  // Rewire around the knockout through a new node, and drop a triangle edge.
+  tangle::NodeId x = overlay.add_node();
+  REQUIRE(x == 6);
+  overlay.add_edge(1, x, 0.5);
+  overlay.add_edge(x, 3, 0.5);
+  overlay.remove_edge(4, 5);
+  REQUIRE(overlay.degree(x) == 2);
+  REQUIRE(overlay.degree(4) == 1);
+  REQUIRE(tangle::algo::distances_from(overlay, 0)[5] == 4);
+  REQUIRE_THROWS_AS(overlay.add_edge(2, 4), std::invalid_argument);
+
+  // The base graph is untouched and reset() restores it.
+  REQUIRE(base.degree(2) == 2);
+  overlay.reset();
+  REQUIRE(overlay.empty());
+  REQUIRE(overlay.num_nodes() == 6);
+  REQUIRE(overlay.has_edge(4, 5));
+  REQUIRE(tangle::algo::distances_from(overlay, 0)[5] == 4);
+
+  auto impact = tangle::algo::knockout_impact(base, {2, 4, 0}, 2);
+  REQUIRE(impact[0].largest_component == 3);
+  REQUIRE(impact[0].num_components == 2);
+  REQUIRE(impact[1].largest_component == 5);
+  REQUIRE(impact[1].num_components == 1);
+  REQUIRE(impact[2].largest_component == 5);
+}
+
+TEST_CASE("BFS traversal and shortest paths", "[algo][traversal]") {
+  // Path 0-1-2-3 with a shortcut 0-4-3, plus an isolated node 5.
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i <= 5; ++i) {
+    g.get_or_add_node(std::to_string(i));
+  }
+  g.add_edge(0, 1);
+  g.add_edge(1, 2);
+  g.add_edge(2, 3);
+  g.add_edge(0, 4);
+  g.add_edge(4, 3);
+  tangle::graph::CsrGraph csr(g);
+
+  SECTION("Distances") {
+    auto dist = tangle::algo::distances_from(csr, 0);
+    REQUIRE(dist == std::vector<std::uint32_t>{0, 1, 2, 2, 1,
+                                               tangle::algo::kUnreachable});
+  }
+
+  SECTION("Shortest path") {
+    auto path = tangle::algo::shortest_path(csr, 0, 3);
+    REQUIRE(path == std::vector<tangle::NodeId>{0, 4, 3});
+    REQUIRE(tangle::algo::shortest_path(csr, 0, 5).empty());
+    REQUIRE(tangle::algo::shortest_path(csr, 2, 2) ==
+            std::vector<tangle::NodeId>{2});
+  }
+
+  SECTION("Ego network") {
+    REQUIRE(tangle::algo::k_hop_neighborhood(csr, 1, 1) ==
+            std::vector<tangle::NodeId>{0, 1, 2});
+    auto ego = tangle::algo::ego_network(g, 0, 1);
+    REQUIRE(ego.num_nodes() == 3);
+    REQUIRE(ego.num_edges() == 2);
+  }
+
+  SECTION("Direction switching matches a serial BFS on a hub-heavy graph") {
+    // Hubs every 100 nodes, each connected to a spread of leaves, and a
+    // sparse ring so the graph is connected with a small diameter.
+    tangle::graph::PpiGraph hubby;
+    const int n = 20000;
+    for (int i = 0; i < n; ++i) {
+      hubby.get_or_add_node(std::to_string(i));
+    }
+    for (int i = 0; i < n; ++i) {
+      hubby.add_edge(i, (i + 1) % n);
+      hubby.add_edge(i, (i * 37) % 200 * 100);
+    }
+    tangle::graph::CsrGraph hcsr(hubby);
+
+    std::vector<std::uint32_t> expected(n, tangle::algo::kUnreachable);
+    std::vector<tangle::NodeId> queue = {5};
+    expected[5] = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      tangle::NodeId u = queue[head];
+      for (tangle::NodeId v : hcsr.neighbors(u)) {
+        if (expected[v] == tangle::algo::kUnreachable) {
+          expected[v] = expected[u] + 1;
+          queue.push_back(v);
+        }
+      }
+    }
+
+    auto result = tangle::algo::bfs(hcsr, {5}, tangle::algo::kNoParent, 4);
+    REQUIRE(result.distance == expected);
+    bool parents_valid = true;
+    for (tangle::NodeId v = 0; v < n; ++v) {
+      if (v == 5) continue;
+      parents_valid = parents_valid &&
+                      expected[result.parent[v]] + 1 == expected[v];
+    }
+    REQUIRE(parents_valid);
+  }
+}
+
+TEST_CASE("Weighted shortest paths from STRING scores", "[algo][paths]") {
+  // Direct edge A-D is low confidence; the detour A-B-C-D is high confidence.
+  tangle::graph::PpiGraph g;
+  auto a = g.get_or_add_node("A");
+  auto b = g.get_or_add_node("B");
+  auto c = g.get_or_add_node("C");
+  auto d = g.get_or_add_node("D");
+  auto e = g.get_or_add_node("E");
+  g.add_edge(a, d, 150);
+  g.add_edge(a, b, 990);
+  g.add_edge(b, c, 980);
+  g.add_edge(c, d, 990);
+  tangle::graph::CsrGraph csr(g);
+  auto lengths = tangle::algo::confidence_lengths(csr, 1000.0);
+
+  SECTION("Most confident path") {
+    auto path = tangle::algo::shortest_weighted_path(csr, lengths, a, d);
+    REQUIRE(path.nodes == std::vector<tangle::NodeId>{a, b, c, d});
+    REQUIRE(std::exp(-path.length) == Approx(0.99 * 0.98 * 0.99));
+    REQUIRE(tangle::algo::shortest_weighted_path(csr, lengths, a, e)
+                .nodes.empty());
+  }
+
+  SECTION("Many-to-many matrix agrees with single-source Dijkstra") {
+    auto matrix =
+        tangle::algo::distance_matrix(csr, lengths, {a, c}, {d, b, e}, 2);
+    auto from_a = tangle::algo::dijkstra(csr, lengths, a);
+    auto from_c = tangle::algo::dijkstra(csr, lengths, c);
+    REQUIRE(matrix[0][0] == Approx(from_a[d]));
+    REQUIRE(matrix[0][1] == Approx(from_a[b]));
+    REQUIRE(matrix[1][1] == Approx(from_c[b]));
+    REQUIRE(matrix[1][2] == tangle::algo::kInfiniteDistance);
+  }
+
+  SECTION("Bidirectional search matches Dijkstra on a larger graph") {
+    tangle::graph::PpiGraph big;
+    const int n = 2000;
+    for (int i = 0; i < n; ++i) {
+      big.get_or_add_node(std::to_string(i));
+    }
+    for (int i = 0; i < n; ++i) {
+      big.add_edge(i, (i + 1) % n, 400 + (i * 31) % 600);
+      big.add_edge(i, (i * 17 + 5) % n, 150 + (i * 7) % 850);
+    }
+    tangle::graph::CsrGraph bcsr(big);
+    auto blengths = tangle::algo::confidence_lengths(bcsr);
+    auto reference = tangle::algo::dijkstra(bcsr, blengths, 3);
+    for (tangle::NodeId t : {0u, 999u, 1500u, 1999u}) {
+      auto path = tangle::algo::shortest_weighted_path(bcsr, blengths, 3, t);
+      REQUIRE(path.length == Approx(reference[t]));
+      REQUIRE(path.nodes.front() == 3);
+      REQUIRE(path.nodes.back() == t);
+    }
+  }
+}
+
+TEST_CASE("Drug-disease network proximity", "[algo][proximity]") {
+  // Ring of 200 nodes; targets sit right next to the disease module.
+  tangle::graph::PpiGraph g;
+  const int n = 200;
+  for (int i = 0; i < n; ++i) {
+    g.get_or_add_node("P" + std::to_string(i));
+  }
+  for (int i = 0; i < n; ++i) {
+    g.add_edge(i, (i + 1) % n);
+  }
+
+  tangle::algo::NetworkProximity proximity(g, 50);
+  std::vector<tangle::ProteinId> targets = {"P10", "P20", "UNKNOWN"};
+  std::vector<tangle::ProteinId> disease = {"P11", "P21", "P100"};
+
+  auto res = proximity.compute(targets, disease, 200, 42, 4);
+  REQUIRE(res.num_targets == 2);
+  REQUIRE(res.num_disease_genes == 3);
+  REQUIRE(res.distance == Approx(1.0));
+  REQUIRE(res.num_samples == 200);
+  REQUIRE(res.random_mean > res.distance);
+  REQUIRE(res.z_score < 0.0);
+
+  // Seeded sampling is independent of the thread count.
+  auto again = proximity.compute(targets, disease, 200, 42, 1);
+  REQUIRE(again.random_mean == res.random_mean);
+  REQUIRE(again.random_sd == res.random_sd);
+}
+
+TEST_CASE("Degree-preserving null models", "[algo][null_model]") {
+  // Two dense clusters joined by a bridge, with one duplicated edge.
+  tangle::graph::PpiGraph g;
+  const int n = 60;
+  for (int i = 0; i < n; ++i) {
+    g.get_or_add_node(std::to_string(i));
+  }
+  for (int i = 0; i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) {
+      if ((i < 30) == (j < 30) && (i + j) % 3 == 0) {
+        g.add_edge(i, j);
+      }
+    }
+  }
+  g.add_edge(0, 59);
+  g.add_edge(59, 0);
+
+  tangle::graph::CsrGraph original(g);
+  auto edges = tangle::algo::randomize_edges(g, 10.0, 7, 4);
+  REQUIRE(edges.size() == original.num_edges());
+
+  tangle::graph::CsrGraph shuffled(g.num_nodes(), edges);
+  REQUIRE(shuffled.num_edges() == edges.size()); // no multi-edges
+  bool same_degrees = true;
+  bool any_loop = false;
+  for (tangle::NodeId v = 0; v < n; ++v) {
+    same_degrees = same_degrees && shuffled.degree(v) == original.degree(v);
+  }
+  for (const auto &e : edges) {
+    any_loop = any_loop || e.u == e.v;
+  }
+  REQUIRE(same_degrees);
+  REQUIRE_FALSE(any_loop);
+
+  // The swaps should have mixed the two clusters.
+  std::size_t cross = 0;
+  for (const auto &e : edges) {
+    if ((e.u < 30) != (e.v < 30)) cross++;
+  }
+  REQUIRE(cross > 1);
+
+  std::size_t produced = 0;
+  tangle::algo::generate_null_models(
+      g, 3,
+      [&](std::size_t, const std::vector<tangle::graph::Edge> &null_edges) {
+        REQUIRE(null_edges.size() == original.num_edges());
+        produced++;
+      });
+  REQUIRE(produced == 3);
+}
+
+TEST_CASE("CSR adjacency and triangle metrics", "[graph][algo][metrics]") {
+  // A 4-clique (0-3) with a pendant node 4 attached to 3. Edges are listed
+  // in both directions, duplicated, and with a self-loop to exercise dedup.
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i <= 4; ++i) {
+    g.get_or_add_node(std::to_string(i));
+  }
+  g.add_edge(0, 1, 0.5);
+  g.add_edge(1, 0, 0.9);
+  g.add_edge(0, 2);
+  g.add_edge(0, 3);
+  g.add_edge(1, 2);
+  g.add_edge(1, 3);
+  g.add_edge(2, 3);
+  g.add_edge(3, 2);
+  g.add_edge(3, 4);
+  g.add_edge(4, 4);
+
+  tangle::graph::CsrGraph csr(g);
+
+  SECTION("CSR is sorted and deduplicated") {
+    REQUIRE(csr.num_nodes() == 5);
+    REQUIRE(csr.num_edges() == 7);
+    auto n3 = csr.neighbors(3);
+    REQUIRE(std::vector<tangle::NodeId>(n3.begin(), n3.end()) ==
+            std::vector<tangle::NodeId>{0, 1, 2, 4});
+    REQUIRE(csr.degree(4) == 1);
+    REQUIRE(csr.neighbor_weights(0)[0] == Approx(0.9)); // max weight kept
+  }
+
+  SECTION("Triangle counts") {
+    REQUIRE(tangle::algo::count_triangles(csr, 4) == 4);
+    REQUIRE(tangle::algo::node_triangles(csr, 4) ==
+            std::vector<std::uint64_t>{3, 3, 3, 3, 0});
+  }
+
+  SECTION("Local clustering coefficient") {
+    auto cc = tangle::algo::clustering_coefficient(g);
+    REQUIRE(cc[0] == Approx(1.0));
+    REQUIRE(cc[3] == Approx(0.5));
+    REQUIRE(cc[4] == 0.0);
+  }
+
+  SECTION("SIMD kernel agrees with brute force on a dense graph") {
+    tangle::graph::PpiGraph dense;
+    const int n = 40;
+    for (int i = 0; i < n; ++i) {
+      dense.get_or_add_node(std::to_string(i));
+    }
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        if ((i * 7 + j * 13) % 3 != 0) {
+          dense.add_edge(i, j);
+        }
+      }
+    }
+    tangle::graph::CsrGraph dcsr(dense);
+    std::uint64_t brute = 0;
+    for (tangle::NodeId a = 0; a < n; ++a) {
+      for (tangle::NodeId b : dcsr.neighbors(a)) {
+        if (b <= a) continue;
+        for (tangle::NodeId c : dcsr.neighbors(b)) {
+          if (c <= b) continue;
+          auto na = dcsr.neighbors(a);
+          if (std::binary_search(na.begin(), na.end(), c)) brute++;
+        }
+      }
+    }
+    REQUIRE(tangle::algo::count_triangles(dcsr, 3) == brute);
+  }
+}
+
+TEST_CASE("Semi-external processing over binary edge files",
+          "[io][algo][streaming]") {
+  // Two 5-cliques joined by one edge, plus an isolated pair.
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i < 12; ++i) {
+    g.get_or_add_node("P" + std::to_string(i));
+  }
+  for (int c = 0; c < 2; ++c) {
+    for (int i = 0; i < 5; ++i) {
+      for (int j = i + 1; j < 5; ++j) {
+        g.add_edge(c * 5 + i, c * 5 + j, 0.5);
+      }
+    }
+  }
+  g.add_edge(4, 5);
+  g.add_edge(10, 11);
+
+  const std::string path = "test_stream_edges.bin";
+  tangle::io::save_edge_file(g, path);
+  REQUIRE(tangle::io::is_edge_file(path));
+  REQUIRE(tangle::io::load_node_table(path)[7] == "P7");
+
+  tangle::io::EdgeStream stream(path, 3); // small batches force many reads
+  REQUIRE(stream.num_nodes() == 12);
+  REQUIRE(stream.num_edges() == g.num_edges());
+
+  REQUIRE(tangle::algo::degree_centrality(stream) ==
+          tangle::algo::degree_centrality(g));
+  REQUIRE(tangle::algo::degree_centrality(stream, true) ==
+          tangle::algo::degree_centrality(g, true));
+  REQUIRE(tangle::algo::connected_components(stream, 2) ==
+          tangle::algo::connected_components(g));
+
+  auto labels = tangle::algo::label_propagation(stream);
+  REQUIRE(labels[0] == labels[3]);
+  REQUIRE(labels[5] == labels[9]);
+  REQUIRE(labels[0] != labels[9]);
+  REQUIRE(labels[10] != labels[0]);
+
+  auto rank = tangle::algo::pagerank(stream);
+  REQUIRE(std::accumulate(rank.begin(), rank.end(), 0.0) == Approx(1.0));
+  REQUIRE(rank[4] > rank[0]);
+  REQUIRE(rank[0] == Approx(rank[9]));
+  REQUIRE(rank[10] == Approx(rank[11]));
+
+  SECTION("Text edgelists convert without building a PpiGraph") {
+    std::string text = create_temp_edgelist_file("A\tB\nB\tC\n# note\nD\tE\n",
+                                                 "test_stream_text_");
+    auto names = tangle::io::convert_edgelist(text, path);
+    REQUIRE(names == std::vector<tangle::ProteinId>{"A", "B", "C", "D", "E"});
+    tangle::io::EdgeStream converted(path);
+    REQUIRE(converted.num_edges() == 3);
+    REQUIRE(tangle::algo::connected_components(converted) ==
+            std::vector<tangle::NodeId>{0, 0, 0, 1, 1});
+    std::remove(text.c_str());
+  }
+
+  std::string not_binary = create_temp_edgelist_file("x\ty\n", "test_stream_bad_");
+  REQUIRE_FALSE(tangle::io::is_edge_file(not_binary));
+  REQUIRE_THROWS_AS(tangle::io::EdgeStream(not_binary), std::runtime_error);
+  std::remove(not_binary.c_str());
+
+  // A writer abandoned without finish() (e.g. on a parse error) must not
+  // leave a file that looks complete.
+  std::string partial = path + ".partial";
+  {
+    tangle::io::EdgeFileWriter writer(partial, 2);
+    for (tangle::NodeId v = 0; v < 5; ++v) {
+      writer.add_edge(v, v + 1);
+    }
+  }
+  REQUIRE_FALSE(tangle::io::is_edge_file(partial));
+  REQUIRE_THROWS_AS(tangle::io::EdgeStream(partial), std::runtime_error);
+  std::remove(partial.c_str());
+  std::remove(path.c_str());
+  std::remove((path + ".nodes").c_str());
+}
+
+TEST_CASE("Cache-friendly node reordering", "[graph][algo][reorder]") {
+  // Ten 6-cliques joined in a ring, with NodeIds scattered by a stride.
+  const tangle::NodeId cliques = 10, size = 6, n = cliques * size;
+  auto id = [&](tangle::NodeId c, tangle::NodeId i) {
+    return ((c * size + i) * 7) % n;
+  };
+  std::vector<tangle::graph::Edge> edges;
+  for (tangle::NodeId c = 0; c < cliques; ++c) {
+    for (tangle::NodeId i = 0; i < size; ++i) {
+      for (tangle::NodeId j = i + 1; j < size; ++j) {
+        edges.push_back({id(c, i), id(c, j), 1.0});
+      }
+    }
+    edges.push_back({id(c, 0), id((c + 1) % cliques, 1), 1.0});
+  }
+  tangle::graph::CsrGraph csr(n, edges);
+
+  auto bandwidth = [](const tangle::graph::CsrGraph &g) {
+    std::size_t b = 0;
+    for (tangle::NodeId v = 0; v < g.num_nodes(); ++v) {
+      for (tangle::NodeId u : g.neighbors(v)) {
+        b = std::max<std::size_t>(b, u > v ? u - v : v - u);
+      }
+    }
+    return b;
+  };
+
+  for (auto order : {tangle::algo::NodeOrder::Degree,
+                     tangle::algo::NodeOrder::Rcm,
+                     tangle::algo::NodeOrder::Rabbit}) {
+    tangle::algo::ReorderedGraph reordered(csr, order);
+    const auto &g = reordered.graph();
+    REQUIRE(g.num_nodes() == n);
+    REQUIRE(g.num_edges() == csr.num_edges());
+    bool consistent = true;
+    for (tangle::NodeId v = 0; v < n; ++v) {
+      consistent = consistent && reordered.to_original(reordered.to_reordered(v)) == v;
+      consistent = consistent && g.degree(reordered.to_reordered(v)) == csr.degree(v);
+      for (tangle::NodeId u : csr.neighbors(v)) {
+        auto nbrs = g.neighbors(reordered.to_reordered(v));
+        consistent = consistent && std::binary_search(nbrs.begin(), nbrs.end(),
+                                                      reordered.to_reordered(u));
+      }
+    }
+    REQUIRE(consistent);
+  }
+
+  auto degree_ids = tangle::algo::degree_order(csr);
+  REQUIRE(csr.degree(std::find(degree_ids.begin(), degree_ids.end(), 0) -
+                     degree_ids.begin()) == 6);
+
+  tangle::algo::ReorderedGraph rcm(csr, tangle::algo::NodeOrder::Rcm);
+  REQUIRE(bandwidth(rcm.graph()) < bandwidth(csr));
+
+  // Rabbit order keeps every clique within a narrow id window.
+  tangle::algo::ReorderedGraph rabbit(csr, tangle::algo::NodeOrder::Rabbit);
+  bool local = true;
+  for (tangle::NodeId c = 0; c < cliques; ++c) {
+    tangle::NodeId lo = n, hi = 0;
+    for (tangle::NodeId i = 0; i < size; ++i) {
+      lo = std::min(lo, rabbit.to_reordered(id(c, i)));
+      hi = std::max(hi, rabbit.to_reordered(id(c, i)));
+    }
+    local = local && hi - lo < 2 * size;
+  }
+  REQUIRE(local);
+
+  std::vector<int> values(n);
+  std::iota(values.begin(), values.end(), 0);
+  auto mapped = rabbit.to_original(values);
+  REQUIRE(mapped[id(3, 2)] == static_cast<int>(rabbit.to_reordered(id(3, 2))));
+  REQUIRE_THROWS_AS(tangle::algo::parse_node_order("random"),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Consensus clustering over seeded Louvain runs", "[algo][community]") {
+  // Three 5-cliques in a chain, joined by single bridge edges.
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i < 15; ++i) {
+    g.get_or_add_node(std::to_string(i));
+  }
+  for (int c = 0; c < 3; ++c) {
+    for (int i = 0; i < 5; ++i) {
+      for (int j = i + 1; j < 5; ++j) {
+        g.add_edge(c * 5 + i, c * 5 + j);
+      }
+    }
+  }
+  g.add_edge(4, 5);
+  g.add_edge(9, 10);
+
+  SECTION("Seeded Louvain is reproducible") {
+    tangle::graph::CsrGraph csr(g);
+    REQUIRE(tangle::algo::louvain_membership(csr, false, 11) ==
+            tangle::algo::louvain_membership(csr, false, 11));
+  }
+
+  SECTION("Consensus recovers the cliques") {
+    auto communities = tangle::algo::consensus_communities(g, 16, false, 0.5, 3);
+    REQUIRE(communities.size() == 3);
+    REQUIRE(communities[0] == std::vector<tangle::NodeId>{0, 1, 2, 3, 4});
+    REQUIRE(communities[1] == std::vector<tangle::NodeId>{5, 6, 7, 8, 9});
+    REQUIRE(communities[2] ==
+            std::vector<tangle::NodeId>{10, 11, 12, 13, 14});
+
+    // Independent of the number of threads.
+    REQUIRE(tangle::algo::consensus_communities(g, 16, false, 0.5, 3, 20, 1) ==
+            communities);
+  }
+
+  SECTION("Incremental update after an edge delta") {
+    tangle::graph::CsrGraph before(g);
+    auto initial = tangle::algo::louvain_membership(before, false, 1);
+    tangle::algo::DynamicLouvain dynamic(before, initial);
+
+    // Node 4 leaves the first clique and joins the second; a new 5-clique
+    // (nodes 15-19) attaches to node 14.
+    std::vector<tangle::graph::Edge> removed = {
+        {4, 0, 1.0}, {4, 1, 1.0}, {4, 2, 1.0}, {4, 3, 1.0}};
+    std::vector<tangle::graph::Edge> added = {
+        {4, 6, 1.0}, {4, 7, 1.0}, {4, 8, 1.0}, {14, 15, 1.0}};
+    for (int i = 15; i < 20; ++i) {
+      for (int j = i + 1; j < 20; ++j) {
+        added.push_back({static_cast<tangle::NodeId>(i),
+                         static_cast<tangle::NodeId>(j), 1.0});
+      }
+    }
+
+    tangle::graph::PpiGraph after_graph;
+    for (int i = 0; i < 20; ++i) {
+      after_graph.get_or_add_node(std::to_string(i));
+    }
+    for (const auto &e : g.edges()) {
+      bool gone = false;
+      for (const auto &r : removed) {
+        gone = gone || (e.u == r.u && e.v == r.v) || (e.u == r.v && e.v == r.u);
+      }
+      if (!gone) after_graph.add_edge(e.u, e.v);
+    }
+    for (const auto &e : added) after_graph.add_edge(e.u, e.v);
+    tangle::graph::CsrGraph after(after_graph);
+
+    std::size_t evaluated = dynamic.update(after, added, removed);
+    auto labels = dynamic.membership();
+    REQUIRE(labels[4] == labels[5]);
+    REQUIRE(labels[0] != labels[4]);
+    REQUIRE(labels[15] == labels[19]);
+    REQUIRE(labels[15] != labels[14]);
+    REQUIRE(tangle::algo::communities_from_membership(labels).size() == 4);
+    REQUIRE(evaluated > 0);
+  }
+
+  SECTION("Warm-started resolution sweep") {
+    tangle::graph::CsrGraph csr(g);
+    std::vector<double> gammas = {1.0, 0.05, 8.0, 0.5, 2.0};
+    auto sweep = tangle::algo::resolution_sweep(csr, gammas, false, 5, 2);
+    REQUIRE(sweep.num_nodes == 15);
+    REQUIRE(sweep.membership.size() == gammas.size() * 15);
+    REQUIRE(sweep.num_communities[0] == 3);  // γ = 1
+    REQUIRE(sweep.num_communities[1] <= 3);  // γ = 0.05 never splits further
+    REQUIRE(sweep.num_communities[2] > 3);   // γ = 8 splits the cliques
+    REQUIRE(sweep.label(0, 0) == sweep.label(0, 4));
+    REQUIRE(sweep.label(0, 4) != sweep.label(0, 5));
+  }
+}
+
+TEST_CASE("Louvain sweeps shared between threads", "[algo][community]") {
+  SECTION("Sweep chains warm-start from the previous resolution") {
+    // A random graph, so that warm and cold starts settle differently.
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<tangle::NodeId> pick(0, 59);
+    std::vector<tangle::graph::Edge> edges;
+    for (int e = 0; e < 150; ++e) {
+      tangle::NodeId u = pick(rng), v = pick(rng);
+      if (u != v) edges.push_back({u, v, 1.0});
+    }
+    tangle::graph::CsrGraph csr(60, edges);
+
+    // Already sorted from largest to smallest. With 8 threads the eight
+    // resolutions still form two chains of four, not eight cold starts.
+    std::vector<double> gammas = {8.0, 4.0, 2.0, 1.5, 1.0, 0.5, 0.2, 0.05};
+    auto sweep = tangle::algo::resolution_sweep(csr, gammas, false, 5, 8);
+    auto row = [&](std::size_t r) {
+      return std::vector<tangle::NodeId>(sweep.membership.begin() + r * 60,
+                                         sweep.membership.begin() + (r + 1) * 60);
+    };
+    bool differs_from_cold = false;
+    for (std::size_t r = 0; r < gammas.size(); ++r) {
+      auto cold = tangle::algo::louvain_membership(csr, false, 5 + r, gammas[r], {}, 4);
+      if (r % 4 == 0) {
+        REQUIRE(row(r) == cold);
+        continue;
+      }
+      REQUIRE(row(r) == tangle::algo::louvain_membership(csr, false, 5 + r, gammas[r],
+                                                         row(r - 1), 4));
+      differs_from_cold = differs_from_cold || row(r) != cold;
+    }
+    REQUIRE(differs_from_cold);
+  }
+
+  SECTION("Batched sweeps do not depend on the thread count") {
+    // 600 8-cliques in a ring, enough nodes for the batched parallel sweep.
+    const int cliques = 600;
+    const int size = 8;
+    std::vector<tangle::graph::Edge> edges;
+    for (int c = 0; c < cliques; ++c) {
+      for (int i = 0; i < size; ++i) {
+        for (int j = i + 1; j < size; ++j) {
+          edges.push_back({static_cast<tangle::NodeId>(c * size + i),
+                           static_cast<tangle::NodeId>(c * size + j), 1.0});
+        }
+      }
+      edges.push_back({static_cast<tangle::NodeId>(c * size),
+                       static_cast<tangle::NodeId>(((c + 1) % cliques) * size + 1),
+                       1.0});
+    }
+    tangle::graph::CsrGraph csr(cliques * size, edges);
+
+    auto two = tangle::algo::louvain_membership(csr, false, 3, 1.0, {}, 2);
+    auto eight = tangle::algo::louvain_membership(csr, false, 3, 1.0, {}, 8);
+    REQUIRE(two == eight);
+    for (int c = 0; c < cliques; ++c) {
+      for (int i = 1; i < size; ++i) {
+        REQUIRE(two[c * size] == two[c * size + i]);
+      }
+    }
+
+    // Warm-started from the result, nothing moves.
+    REQUIRE(tangle::algo::louvain_membership(csr, false, 4, 1.0, two, 8) == two);
+  }
+}
+
+TEST_CASE("Partition quality and comparison", "[algo][quality]") {
+  // Two 4-cliques joined by one bridge edge (m = 13).
+  tangle::graph::PpiGraph g;
+  for (int i = 0; i < 8; ++i) {
+    g.get_or_add_node(std::to_string(i));
+  }
+  for (int c = 0; c < 2; ++c) {
+    for (int i = 0; i < 4; ++i) {
+      for (int j = i + 1; j < 4; ++j) {
+        g.add_edge(c * 4 + i, c * 4 + j);
+      }
+    }
+  }
+  g.add_edge(0, 4);
+  tangle::graph::CsrGraph csr(g);
+
+  std::vector<tangle::NodeId> split = {0, 0, 0, 0, 1, 1, 1, 1};
+  auto q = tangle::algo::evaluate_partition(csr, split, false, 1.0, 3);
+  REQUIRE(q.modularity == Approx(12.0 / 13.0 - 0.5));
+  REQUIRE(q.cpm == Approx(0.0));
+  REQUIRE(q.coverage == Approx(12.0 / 13.0));
+  REQUIRE(q.communities.size() == 2);
+  REQUIRE(q.communities[0].internal_weight == Approx(6.0));
+  REQUIRE(q.communities[0].density == Approx(1.0));
+  REQUIRE(q.communities[1].conductance == Approx(1.0 / 13.0));
+
+  auto from_lists = tangle::algo::membership_from_communities(
+      {{4, 5, 6, 7}, {0, 1, 2, 3}}, 8);
+  REQUIRE(tangle::algo::normalized_mutual_information(split, from_lists) ==
+          Approx(1.0));
+  REQUIRE(tangle::algo::adjusted_rand_index(split, from_lists) == Approx(1.0));
+
+  // Reference values (scikit-learn) for a partial agreement.
+  std::vector<tangle::NodeId> a = {0, 0, 1, 1};
+  std::vector<tangle::NodeId> b = {0, 0, 1, 2};
+  REQUIRE(tangle::algo::normalized_mutual_information(a, b) == Approx(0.8));
+  REQUIRE(tangle::algo::adjusted_rand_index(a, b) == Approx(4.0 / 7.0));
+}
+
 TEST_CASE("GO Annotation and Enrichment", "[annotate]") {
   // 1. Load annotations from the dummy GAF file
   tangle::annotate::AnnotationDb db;
@@ -255,6 +1376,153 @@ TEST_CASE("GO Annotation and Enrichment", "[annotate]") {
   }
 }
 
+TEST_CASE("GAF loading with row filters", "[annotate][gaf]") {
+  // Columns: DB, ID, Symbol, Qualifier, GO, Ref, Evidence, With, Aspect,
+  // Name, Synonyms, Type, Taxon.
+  auto row = [](const std::string &id, const std::string &qualifier,
+                const std::string &go, const std::string &evidence,
+                const std::string &aspect, const std::string &taxon) {
+    return "UniProtKB\t" + id + "\tS" + id + "\t" + qualifier + "\t" + go +
+           "\tPMID:1\t" + evidence + "\t\t" + aspect +
+           "\tname\t\tprotein\ttaxon:" + taxon + "\t20240101\tUniProt\r\n";
+  };
+  std::string content = "!gaf-version: 2.2\n" +
+                        row("P1", "enables", "GO:0000002", "IDA", "F", "9606") +
+                        row("P1", "enables", "GO:0000001", "IDA", "F", "9606") +
+                        row("P1", "NOT|enables", "GO:0000003", "IDA", "F", "9606") +
+                        row("P2", "located_in", "GO:0000004", "IEA", "C", "9606") +
+                        row("P2", "enables", "GO:0000001", "EXP", "F", "9606|10090") +
+                        row("P3", "enables", "GO:0000001", "IDA", "F", "10090") +
+                        "UniProtKB\tP4\tSP4\n"; // truncated row
+  std::string path = create_temp_edgelist_file(content, "gaf_filter_");
+
+  tangle::annotate::AnnotationDb all;
+  all.load_from_gaf(path);
+  REQUIRE(all.get_annotations("P1") ==
+          std::vector<std::string>{"GO:0000001", "GO:0000002", "GO:0000003"});
+  REQUIRE(all.get_annotations("SP1") == all.get_annotations("P1"));
+  REQUIRE(all.get_all_go_terms().size() == 4);
+  REQUIRE(all.get_all_annotated_proteins().size() == 6); // ids and symbols
+  REQUIRE(all.get_term_frequency("GO:0000001") == 6);
+  REQUIRE_FALSE(all.has_annotations("P4"));
+
+  tangle::annotate::GafFilter filter;
+  filter.skip_negated = true;
+  filter.excluded_evidence = {"IEA"};
+  filter.aspects = "FP";
+  filter.taxon = "9606";
+  filter.threads = 3;
+  tangle::annotate::AnnotationDb db;
+  db.load_from_gaf(path, filter);
+  REQUIRE(db.get_annotations("P1") ==
+          std::vector<std::string>{"GO:0000001", "GO:0000002"});
+  REQUIRE(db.get_annotations("P2") == std::vector<std::string>{"GO:0000001"});
+  REQUIRE_FALSE(db.has_annotations("P3"));
+  REQUIRE(db.get_all_go_terms() ==
+          std::vector<std::string>{"GO:0000001", "GO:0000002"});
+  REQUIRE(db.get_term_frequency("GO:0000001") == 4);
+
+  std::vector<std::string> visited;
+  db.for_each_annotation("P1", [&](std::size_t term, std::string_view go_term,
+                                   std::size_t frequency) {
+    REQUIRE(frequency == static_cast<std::size_t>(
+                             db.get_term_frequency(std::string(go_term))));
+    visited.push_back(std::to_string(term) + ":" + std::string(go_term));
+  });
+  REQUIRE(visited ==
+          std::vector<std::string>{"0:GO:0000001", "1:GO:0000002"});
+  db.for_each_annotation("P3", [&](std::size_t, std::string_view, std::size_t) {
+    FAIL("P3 has no annotations");
+  });
+
+  tangle::annotate::GafFilter experimental;
+  experimental.evidence_codes = {"EXP"};
+  db.load_from_gaf(path, experimental);
+  REQUIRE(db.get_all_annotated_proteins().size() == 2);
+  REQUIRE(db.get_annotations("SP2") == std::vector<std::string>{"GO:0000001"});
+
+  REQUIRE_THROWS_AS(db.load_from_gaf(path + ".missing", filter),
+                    std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST_CASE("AnnotationDb binary snapshot", "[annotate][snapshot]") {
+  std::string content = "!gaf-version: 2.2\n"
+                        "UniProtKB\tP2\tS2\t\tGO:0000003\tPMID:1\n"
+                        "UniProtKB\tP1\tS1\t\tGO:0000002\tPMID:1\n"
+                        "UniProtKB\tP1\tS1\t\tGO:0000001\tPMID:1\n"
+                        "UniProtKB\tP1\tS1\t\tGO:0000002\tPMID:1\n"
+                        "UniProtKB\tP3\t\t\tGO:0000001\tPMID:1\n";
+  std::string gaf = create_temp_edgelist_file(content, "gaf_snapshot_");
+  std::string snapshot = gaf + ".tadb";
+
+  tangle::annotate::AnnotationDb parsed;
+  parsed.load_from_gaf(gaf);
+  REQUIRE_FALSE(tangle::annotate::AnnotationDb::is_binary_snapshot(gaf));
+  parsed.save_binary(snapshot);
+  REQUIRE(tangle::annotate::AnnotationDb::is_binary_snapshot(snapshot));
+
+  tangle::annotate::AnnotationDb db;
+  db.open_binary(snapshot);
+  REQUIRE(db.num_annotated_proteins() == 5);
+  REQUIRE(db.get_all_annotated_proteins() ==
+          std::vector<std::string>{"P1", "P2", "P3", "S1", "S2"});
+  REQUIRE(db.get_all_go_terms() == parsed.get_all_go_terms());
+  REQUIRE(db.get_annotations("S1") ==
+          std::vector<std::string>{"GO:0000001", "GO:0000002"});
+  REQUIRE(db.get_annotated_proteins("GO:0000001") ==
+          std::vector<std::string>{"P1", "P3", "S1"});
+  REQUIRE(db.get_term_frequency("GO:0000002") == 2);
+  REQUIRE(db.get_term_frequency("GO:9999999") == 0);
+  REQUIRE_FALSE(db.has_annotations("S3"));
+
+  // Copies share the mapped image and outlive the original.
+  tangle::annotate::AnnotationDb copy = db;
+  db = tangle::annotate::AnnotationDb();
+  REQUIRE(db.num_go_terms() == 0);
+  REQUIRE(copy.get_annotations("P2") == std::vector<std::string>{"GO:0000003"});
+
+  auto enriched = tangle::annotate::go_enrichment({"P1", "S1"}, copy, "none");
+  auto expected = tangle::annotate::go_enrichment({"P1", "S1"}, parsed, "none");
+  REQUIRE(enriched.size() == expected.size());
+  REQUIRE(enriched[0].total_in_background == 5);
+  REQUIRE(enriched[0].p_value == Approx(expected[0].p_value));
+
+  // An empty database round-trips too.
+  tangle::annotate::AnnotationDb().save_binary(snapshot);
+  db.open_binary(snapshot);
+  REQUIRE(db.get_all_annotated_proteins().empty());
+
+  REQUIRE_THROWS_AS(db.open_binary(gaf), std::runtime_error);
+
+  // Corrupt index entries are caught at open time. The header stores the
+  // protein_start and protein_terms section offsets at bytes 64 and 72.
+  parsed.save_binary(snapshot);
+  std::string image;
+  {
+    std::ifstream in(snapshot, std::ios::binary);
+    image.assign(std::istreambuf_iterator<char>(in),
+                 std::istreambuf_iterator<char>());
+  }
+  auto corrupted = [&](size_t field, size_t width, size_t index,
+                       uint64_t value) {
+    uint64_t section = 0;
+    std::memcpy(&section, image.data() + field, sizeof(section));
+    std::string bad = image;
+    std::memcpy(&bad[section + index * width], &value, width);
+    std::ofstream(snapshot, std::ios::binary | std::ios::trunc) << bad;
+    tangle::annotate::AnnotationDb reopened;
+    REQUIRE_THROWS_AS(reopened.open_binary(snapshot), std::runtime_error);
+  };
+  corrupted(72, 4, 0, 0xFFFFFFFFu); // term index past num_terms
+  corrupted(64, 8, 1, 1u << 30);    // protein_start not monotonic
+
+  std::ofstream(snapshot, std::ios::binary | std::ios::trunc) << "TNGLANN1";
+  REQUIRE_THROWS_AS(db.open_binary(snapshot), std::runtime_error);
+  std::remove(gaf.c_str());
+  std::remove(snapshot.c_str());
+}
+
 TEST_CASE("STRING Importer functionality", "[io][string]") {
   // The dummy file is in tests/, and the test runs from the build/ directory
   std::string string_filepath = "../tests/dummy_string.txt";
@@ -280,6 +1548,275 @@ TEST_CASE("STRING Importer functionality", "[io][string]") {
   }
 }
 
+TEST_CASE("Streaming STRING score filter", "[io][string]") {
+  std::string path = create_temp_edgelist_file(
+      "protein1 protein2 combined_score\n"
+      "9606.A 9606.B 900\n"
+      "9606.B 9606.A 900\n"
+      "9606.A 9606.C 400\n"
+      "9606.C 9606.A 400\n"
+      "9606.C 9606.D\n"
+      "9606.D 9606.E n/a\n"
+      "9606.E 9606.D 750\n",
+      "test_string_stream_");
+
+  std::vector<std::string> rows;
+  auto sink = [&](std::string_view p1, std::string_view p2, double score) {
+    rows.push_back(std::string(p1) + "-" + std::string(p2) + ":" +
+                   std::to_string(static_cast<int>(score)));
+  };
+
+  // The E-D pair is kept although its mirror row has no valid score.
+  REQUIRE(tangle::io::filter_string(path, sink, 700.0, 3) == 3);
+  REQUIRE(rows == std::vector<std::string>{"9606.A-9606.B:900",
+                                           "9606.B-9606.A:900",
+                                           "9606.E-9606.D:750"});
+
+  auto g = tangle::io::load_from_string(path, 700.0, 3);
+  REQUIRE(g.num_nodes() == 4);
+  REQUIRE(g.num_edges() == 3);
+  std::remove(path.c_str());
+
+  // Each pair listed once, in either orientation: nothing is lost.
+  std::string one_way = create_temp_edgelist_file(
+      "protein1 protein2 combined_score\n"
+      "B A 900\n"
+      "C B 800\n"
+      "A C 950\n",
+      "test_string_stream_");
+  rows.clear();
+  REQUIRE(tangle::io::filter_string(one_way, sink, 700.0, 3) == 3);
+  std::remove(one_way.c_str());
+
+  // One row per pair of a symmetric file.
+  std::string symmetric = create_temp_edgelist_file(
+      "protein1 protein2 combined_score\n"
+      "9606.A 9606.B 900\n"
+      "9606.B 9606.A 900\n"
+      "9606.C 9606.A 400\n"
+      "9606.A 9606.C 400\n",
+      "test_string_stream_");
+  rows.clear();
+  REQUIRE(tangle::io::filter_string(symmetric, sink, 0.0, 3, ' ', true) == 2);
+  REQUIRE(rows == std::vector<std::string>{"9606.A-9606.B:900",
+                                           "9606.A-9606.C:400"});
+  std::remove(symmetric.c_str());
+}
+
+TEST_CASE("PSI-MITAB importer", "[io][mitab]") {
+  auto row = [](std::vector<std::string> cols) {
+    cols.resize(15, "-");
+    std::string line;
+    for (std::size_t i = 0; i < cols.size(); ++i) {
+      line += (i ? "\t" : "") + cols[i];
+    }
+    return line + "\n";
+  };
+  const std::string human = "taxid:9606(human)|taxid:9606(Homo sapiens)";
+  const std::string two_hybrid = "psi-mi:\"MI:0018\"(two hybrid)";
+  const std::string coip = "psi-mi:\"MI:0006\"(anti bait coip)";
+  const std::string physical = "psi-mi:\"MI:0915\"(physical association)";
+  const std::string direct = "psi-mi:\"MI:0407\"(direct interaction)";
+
+  std::string content =
+      "#ID(s) interactor A\tID(s) interactor B\n" +
+      row({"uniprotkb:P1", "uniprotkb:P2", "intact:EBI-1", "intact:EBI-2", "-", "-",
+           two_hybrid, "-", "pubmed:1", human, human, physical, "-", "-",
+           "intact-miscore:0.80"}) +
+      row({"intact:EBI-3", "uniprotkb:P2", "uniprotkb:P3|intact:EBI-3", "-", "-", "-",
+           coip, "-", "pubmed:2", human, human, direct, "-", "-",
+           "author score:\"high|very\"|intact-miscore:0.40"}) +
+      row({"uniprotkb:Q1", "uniprotkb:Q2", "-", "-", "-", "-", two_hybrid, "-", "-",
+           "taxid:10090(mouse)", "taxid:10090(mouse)", physical, "-", "-",
+           "intact-miscore:0.90"}) +
+      row({"uniprotkb:P4", "-", "-", "-", "-", "-", coip, "-", "-", human, human,
+           physical}) +
+      "uniprotkb:P5\tuniprotkb:P6\t-\t-\n";
+  std::string path = create_temp_edgelist_file(content, "test_mitab_");
+
+  SECTION("UniProt ids, falling back to alternative ids") {
+    auto g = tangle::io::load_from_mitab(path);
+    REQUIRE(g.num_nodes() == 5);
+    REQUIRE(g.num_edges() == 3);
+    REQUIRE(g.find_node("P3").has_value());
+    REQUIRE_FALSE(g.find_node("EBI-3").has_value());
+  }
+
+  SECTION("Other id namespaces") {
+    tangle::io::MitabOptions options;
+    options.id_database = "intact";
+    auto g = tangle::io::load_from_mitab(path, options);
+    REQUIRE(g.num_edges() == 1);
+    REQUIRE(g.find_node("EBI-1").has_value());
+
+    options.id_database.clear();
+    g = tangle::io::load_from_mitab(path, options);
+    REQUIRE(g.num_edges() == 3);
+    REQUIRE(g.find_node("EBI-3").has_value());
+  }
+
+  SECTION("Type, method, taxon and score filters") {
+    tangle::io::MitabOptions options;
+    options.interaction_types = {"MI:0915"};
+    REQUIRE(tangle::io::load_from_mitab(path, options).num_edges() == 2);
+
+    options = {};
+    options.detection_methods = {"MI:0006", "MI:0096"};
+    REQUIRE(tangle::io::load_from_mitab(path, options).num_edges() == 1);
+
+    options = {};
+    options.taxon = "9606";
+    REQUIRE(tangle::io::load_from_mitab(path, options).num_edges() == 2);
+
+    options = {};
+    options.score_name = "intact-miscore";
+    options.min_score = 0.5;
+    auto g = tangle::io::load_from_mitab(path, options);
+    REQUIRE(g.num_edges() == 2);
+    REQUIRE(g.edges()[0].weight == Approx(0.8));
+    REQUIRE(g.edges()[1].weight == Approx(0.9));
+  }
+
+  SECTION("Result does not depend on threads or block size") {
+    std::string big = "#header\r\n";
+    for (int i = 0; i < 3000; ++i) {
+      big += row({"uniprotkb:P" + std::to_string(i % 701),
+                  "uniprotkb:P" + std::to_string((i * 13 + 5) % 701), "-", "-", "-",
+                  "-", i % 3 ? two_hybrid : coip, "-", "-", human, human, physical,
+                  "-", "-", "intact-miscore:0." + std::to_string(i % 10)});
+    }
+    std::string big_path = create_temp_edgelist_file(big, "test_mitab_big_");
+    tangle::io::MitabOptions serial;
+    serial.threads = 1;
+    serial.score_name = "intact-miscore";
+    tangle::io::MitabOptions parallel = serial;
+    parallel.threads = 4;
+    parallel.block_bytes = 257;
+    auto a = tangle::io::load_from_mitab(big_path, serial);
+    auto b = tangle::io::load_from_mitab(big_path, parallel);
+    REQUIRE(a.num_edges() == 3000);
+    REQUIRE(b.num_nodes() == a.num_nodes());
+    REQUIRE(b.num_edges() == a.num_edges());
+    bool same = true;
+    for (tangle::NodeId v = 0; v < a.num_nodes(); ++v) {
+      same = same && a.node(v).protein_id == b.node(v).protein_id;
+    }
+    for (std::size_t i = 0; i < a.num_edges(); ++i) {
+      same = same && a.edges()[i].u == b.edges()[i].u &&
+             a.edges()[i].v == b.edges()[i].v &&
+             a.edges()[i].weight == b.edges()[i].weight;
+    }
+    REQUIRE(same);
+    std::remove(big_path.c_str());
+  }
+
+  REQUIRE_THROWS_AS(tangle::io::load_from_mitab("no_such_file.mitab"),
+                    std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST_CASE("STRING alias mapping", "[io][aliases]") {
+  SECTION("Minimal perfect hash") {
+    std::vector<std::string> names;
+    for (int i = 0; i < 20000; ++i) {
+      names.push_back("9606.ENSP" + std::to_string(1000000 + i * 7));
+    }
+    std::vector<std::string_view> keys(names.begin(), names.end());
+    tangle::PerfectHash hash(keys);
+    REQUIRE(hash.size() == keys.size());
+    std::vector<char> hit(keys.size(), 0);
+    bool exact = true;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      std::size_t slot = hash.find(keys[i]);
+      exact = exact && slot == i;
+      hit[slot] = 1;
+    }
+    REQUIRE(exact);
+    REQUIRE(std::count(hit.begin(), hit.end(), 1) == static_cast<long>(keys.size()));
+    std::vector<std::size_t> batch(keys.size());
+    hash.find_many(keys.data(), keys.size(), batch.data());
+    std::vector<std::size_t> expected(keys.size());
+    std::iota(expected.begin(), expected.end(), std::size_t{0});
+    REQUIRE(batch == expected);
+    REQUIRE(hash.find("not a key") < keys.size());
+    REQUIRE(tangle::PerfectHash().find("x") == tangle::PerfectHash::npos);
+
+    keys.push_back(keys.front());
+    REQUIRE_THROWS_AS(tangle::PerfectHash(keys), std::invalid_argument);
+  }
+
+  std::string path = create_temp_edgelist_file(
+      "#string_protein_id\talias\tsource\n"
+      "9606.ENSP1\tP11111\tEnsembl_UniProt_AC UniProt_AC\n"
+      "9606.ENSP1\tGENE1\tEnsembl_HGNC_symbol\n"
+      "9606.ENSP1\tP11111-2\tUniProt_AC\n"
+      "9606.ENSP2\tP22222\tUniProt_AC\n"
+      "9606.ENSP2\tGENE1\tBioMart_HUGO\n"
+      "9606.ENSP3\tGENE3\tEnsembl_HGNC_symbol\n"
+      "10090.ENSMUSP1\tQ11111\tUniProt_AC\n"
+      "9606.ENSP1\tP11111\tBLAST_UniProt_AC\n",
+      "test_string_aliases_");
+
+  SECTION("Both directions, many-to-many") {
+    tangle::io::StringAliases aliases(path);
+    REQUIRE(aliases.num_proteins() == 4);
+    REQUIRE(aliases.num_aliases() == 6);
+    REQUIRE(aliases.num_pairs() == 7);
+    REQUIRE(aliases.aliases_of("9606.ENSP1") ==
+            std::vector<std::string_view>{"P11111", "GENE1", "P11111-2"});
+    REQUIRE(aliases.proteins_with("GENE1") ==
+            std::vector<std::string_view>{"9606.ENSP1", "9606.ENSP2"});
+    REQUIRE(aliases.aliases_of("9606.ENSP9").empty());
+    REQUIRE(aliases.proteins_with("P9").empty());
+
+    REQUIRE(aliases.to_string_ids({"GENE1", "P22222", "GENE3", "missing"}) ==
+            std::vector<tangle::ProteinId>{"9606.ENSP1", "9606.ENSP2", "9606.ENSP3"});
+  }
+
+  SECTION("Source and taxon filters") {
+    tangle::io::StringAliases aliases(path, {"UniProt_AC"}, "9606");
+    REQUIRE(aliases.num_proteins() == 2);
+    REQUIRE(aliases.aliases_of("9606.ENSP1") ==
+            std::vector<std::string_view>{"P11111", "P11111-2"});
+    REQUIRE(aliases.aliases_of("10090.ENSMUSP1").empty());
+
+    std::vector<tangle::ProteinId> ids = {"9606.ENSP2", "9606.ENSP1", "unknown",
+                                          "9606.ENSP2"};
+    REQUIRE(aliases.to_aliases(ids) ==
+            std::vector<tangle::ProteinId>{"P22222", "P11111", "P11111-2"});
+    REQUIRE(aliases.to_aliases(ids, true, 2) ==
+            std::vector<tangle::ProteinId>{"P22222", "P11111"});
+  }
+
+  SECTION("Relabelling a graph") {
+    tangle::io::StringAliases aliases(path, {"UniProt_AC"});
+    tangle::graph::PpiGraph g;
+    auto a = g.add_node("9606.ENSP1", std::string("G1"));
+    auto b = g.add_node("9606.ENSP2");
+    auto c = g.add_node("9606.ENSP3");
+    auto d = g.add_node("X");
+    g.add_edge(a, b, 0.9);
+    g.add_edge(b, c, 0.5);
+    g.add_edge(c, d, 0.4);
+
+    auto kept = aliases.relabel(g);
+    REQUIRE(kept.num_nodes() == 4);
+    REQUIRE(kept.num_edges() == 3);
+    REQUIRE(kept.node(0).protein_id == "P11111");
+    REQUIRE(kept.node(0).gene_symbol == std::optional<std::string>("G1"));
+    REQUIRE(kept.node(2).protein_id == "9606.ENSP3");
+
+    auto mapped = aliases.relabel(g, false);
+    REQUIRE(mapped.num_nodes() == 2);
+    REQUIRE(mapped.num_edges() == 1);
+    REQUIRE(mapped.edges()[0].weight == Approx(0.9));
+  }
+
+  REQUIRE_THROWS_AS(tangle::io::StringAliases("no_such_aliases.txt"),
+                    std::runtime_error);
+  std::remove(path.c_str());
+}
+
 TEST_CASE("SBML Exporter functionality", "[export][sbml]") {
   // Create a simple graph to export
   tangle::graph::PpiGraph g;
@@ -316,6 +1853,63 @@ TEST_CASE("SBML Exporter functionality", "[export][sbml]") {
           std::string::npos);
 }
 
+TEST_CASE("Streaming SBML export", "[export][sbml]") {
+  tangle::graph::PpiGraph g;
+  g.add_node("9606.ENSP0001");
+  g.add_node("A&B<\"x\">");
+  g.add_node("s1");
+  g.add_node("Valid_ID");
+  g.add_edge(0, 1);
+  g.add_edge(2, 3);
+  std::string path = create_temp_edgelist_file("", "sbml_stream_");
+  auto read_all = [](const std::string &file) {
+    std::ifstream in(file, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)),
+                       std::istreambuf_iterator<char>());
+  };
+
+  tangle::export_::save_to_sbml(g, path);
+  std::string l2 = read_all(path);
+  REQUIRE(l2.find("<species id=\"s0_9606_ENSP0001\" name=\"9606.ENSP0001\"") !=
+          std::string::npos);
+  REQUIRE(l2.find("name=\"A&amp;B&lt;&quot;x&quot;&gt;\"") != std::string::npos);
+  REQUIRE(l2.find("A&B") == std::string::npos);
+  REQUIRE(l2.find("<species id=\"s2_s1\"") != std::string::npos);
+  REQUIRE(l2.find("<species id=\"Valid_ID\"") != std::string::npos);
+  REQUIRE(l2.find("<reaction id=\"r1\"") != std::string::npos);
+  REQUIRE(l2.find("<speciesReference species=\"s1_A_B__x__\"/>") !=
+          std::string::npos);
+
+  tangle::export_::SbmlOptions options;
+  options.format = tangle::export_::SbmlFormat::Level3Qual;
+  options.threads = 3;
+  tangle::export_::save_to_sbml(g, path, options);
+  std::string l3 = read_all(path);
+  REQUIRE(l3.find("level=\"3\"") != std::string::npos);
+  REQUIRE(l3.find("qual:required=\"true\"") != std::string::npos);
+  REQUIRE(l3.find("<qual:qualitativeSpecies qual:id=\"Valid_ID\"") !=
+          std::string::npos);
+  REQUIRE(l3.find("<qual:input qual:id=\"t1_in\" "
+                  "qual:qualitativeSpecies=\"s2_s1\"") != std::string::npos);
+  REQUIRE(l3.find("qual:qualitativeSpecies=\"Valid_ID\" "
+                  "qual:transitionEffect=\"assignmentLevel\"") !=
+          std::string::npos);
+  REQUIRE(l3.substr(l3.size() - 8) == "</sbml>\n");
+
+#ifdef TANGLE_HAVE_ZLIB
+  // Compressed output reads back as the same document.
+  options.compression = tangle::io::Compression::Gzip;
+  tangle::export_::save_to_sbml(g, path, options);
+  REQUIRE(tangle::io::detect_compression(path) ==
+          tangle::io::Compression::Gzip);
+  tangle::io::InputFile in(path);
+  std::string inflated((std::istreambuf_iterator<char>(in)),
+                       std::istreambuf_iterator<char>());
+  REQUIRE(inflated == l3);
+#endif
+  std::remove(path.c_str());
+}
+
 TEST_CASE("Robustness: Edge Cases and Error Handling", "[robustness]") {
   SECTION("Empty file handling") {
     std::string empty_file = create_temp_edgelist_file("", "empty_");